@@ -0,0 +1,106 @@
+#pragma once
+
+#include <Converter/Converter.h>
+#include <Converter/ConverterExport.h>
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string_view>
+
+// Batch conversion of whole arrays of values to and from delimited text
+// The text of every value is the same as getStringForType writes and tryParse accepts.
+//
+// Example usage:
+//    std::vector<int> values = { 1, -2, 3 };
+//    Converter::OutputBuffer out;
+//    Converter::toStrings<int>(values, out);                        // "1,-2,3"
+//    std::vector<int> parsed(values.size());
+//    auto count = Converter::fromStrings<int>(out.view(), parsed);  // 3, or the index and error of the first bad value
+//
+// 32 and 64 bit integers are formatted and parsed with SSE4.1 digit kernels when the CPU has them
+// (checked once at runtime), and with std::to_chars / std::from_chars otherwise.
+// Every other type is converted one value at a time with its converter; pick a delimiter that
+// can't appear in its text (e.g. not ',' for vectors).
+namespace Converter
+{
+	struct BatchError
+	{
+		std::size_t index; // Index of the bad value; values.size() if the text has more values than fit
+		ConvertError error;
+	};
+
+	namespace Impl
+	{
+		template<typename T>
+		concept BatchInteger = std::same_as<T, std::int32_t> || std::same_as<T, std::uint32_t> || std::same_as<T, std::int64_t> || std::same_as<T, std::uint64_t>;
+
+		CONVERTER_EXPORT void formatIntegers(std::span<const std::int32_t> values, OutputBuffer& out, char delimiter);
+		CONVERTER_EXPORT void formatIntegers(std::span<const std::uint32_t> values, OutputBuffer& out, char delimiter);
+		CONVERTER_EXPORT void formatIntegers(std::span<const std::int64_t> values, OutputBuffer& out, char delimiter);
+		CONVERTER_EXPORT void formatIntegers(std::span<const std::uint64_t> values, OutputBuffer& out, char delimiter);
+
+		CONVERTER_EXPORT std::expected<std::size_t, BatchError> parseIntegers(std::string_view str, std::span<std::int32_t> values, char delimiter);
+		CONVERTER_EXPORT std::expected<std::size_t, BatchError> parseIntegers(std::string_view str, std::span<std::uint32_t> values, char delimiter);
+		CONVERTER_EXPORT std::expected<std::size_t, BatchError> parseIntegers(std::string_view str, std::span<std::int64_t> values, char delimiter);
+		CONVERTER_EXPORT std::expected<std::size_t, BatchError> parseIntegers(std::string_view str, std::span<std::uint64_t> values, char delimiter);
+
+		// The kernels picked for this CPU: "sse4.1" or "scalar"
+		CONVERTER_EXPORT std::string_view getBatchKernelName();
+	}
+
+	// Appends values to out, separated by delimiter
+	template<typename T>
+	void toStrings(std::span<const T> values, OutputBuffer& out, char delimiter = ',')
+	{
+		if constexpr (Impl::BatchInteger<T>)
+		{
+			Impl::formatIntegers(values, out, delimiter);
+		}
+		else
+		{
+			for (std::size_t i = 0; i < values.size(); i++)
+			{
+				if (i > 0)
+					out.push_back(delimiter);
+				getStringForType(values[i], out);
+			}
+		}
+	}
+
+	// Parses the delimited values in str into the front of values without throwing
+	// Returns the number of values parsed; an empty str has none.
+	// Errors: the first bad value (see tryParse), or TrailingCharacters at values.size() if str has more values than fit
+	template<typename T>
+	std::expected<std::size_t, BatchError> fromStrings(std::string_view str, std::span<T> values, char delimiter = ',')
+	{
+		if constexpr (Impl::BatchInteger<T>)
+		{
+			return Impl::parseIntegers(str, values, delimiter);
+		}
+		else
+		{
+			if (str.empty())
+				return 0;
+
+			std::size_t count = 0;
+			while (true)
+			{
+				if (count == values.size())
+					return std::unexpected(BatchError{ count, ConvertError::TrailingCharacters });
+
+				const std::size_t end = str.find(delimiter);
+				auto value = tryParse<T>(str.substr(0, end));
+				if (!value)
+					return std::unexpected(BatchError{ count, value.error() });
+
+				values[count++] = std::move(*value);
+				if (end == std::string_view::npos)
+					return count;
+				str.remove_prefix(end + 1);
+			}
+		}
+	}
+}
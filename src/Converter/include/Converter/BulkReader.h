@@ -0,0 +1,198 @@
+#pragma once
+
+#include <Converter/Converter.h>
+#include <Converter/ConverterExport.h>
+
+#include <cstddef>
+#include <expected>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+// Streaming columnar parser for delimited text (one row per line, one field per column)
+// Rows are split in place inside a reusable chunk buffer, or directly inside the caller's memory
+// for the std::string_view source (e.g. a memory-mapped file), and every field is parsed straight
+// into a typed std::vector per column. Converters are resolved once per column: types with
+// Converter::Traits are parsed without any lookup, other types use their registered converter.
+//
+// Example usage:
+//    std::ifstream file("data.csv", std::ios::binary);
+//    Converter::BulkReader<int, double, std::string> reader(file);
+//    Converter::BulkReader<int, double, std::string>::Columns columns;
+//    while (true)
+//    {
+//        auto rows = reader.read(columns, 4096);
+//        if (!rows || *rows == 0) // rows.error() has the line and column of a bad field
+//            break;
+//        ... use std::get<0>(columns), std::get<1>(columns), ...
+//    }
+//
+// Fields can't contain the delimiter or a line break; there is no quoting. "\r\n" line endings are accepted.
+namespace Converter
+{
+	struct BulkOptions
+	{
+		char delimiter = ',';
+		// Number of lines to skip before the first row, e.g. 1 for a header line
+		std::size_t skipLines = 0;
+		// Size of each read from a stream source; the buffer only grows for lines longer than this
+		std::size_t chunkSize = 1 << 20;
+	};
+
+	struct BulkError
+	{
+		std::size_t line;   // 1 based line number in the input
+		std::size_t column; // 0 based column; equal to the column count if the row has too many or too few fields
+		ConvertError error;
+	};
+
+	// Splits delimited input into rows of fields
+	// The returned fields point into the reader's buffer (or the source memory) and are valid until the next call.
+	class CONVERTER_EXPORT RowSplitter
+	{
+	public:
+		RowSplitter(std::istream& stream, const BulkOptions& options);
+		RowSplitter(std::string_view data, const BulkOptions& options);
+
+		// Splits the next line into fields, replacing the contents of fields
+		// Returns false at the end of the input
+		bool nextRow(std::vector<std::string_view>& fields);
+
+		// Line number of the row last returned by nextRow
+		std::size_t getLine() const { return m_line; }
+
+	private:
+		bool nextLine(std::string_view& line);
+		bool fill();
+
+		std::istream* m_stream = nullptr;
+		BulkOptions m_options;
+		std::string m_buffer;
+		// Unconsumed input; points into m_buffer for streams or into the caller's memory
+		std::string_view m_pending;
+		std::size_t m_line = 0;
+	};
+
+	namespace Impl
+	{
+		// Parses one column's fields; the converter is chosen once when the column is created
+		template<typename T>
+		class ColumnParser
+		{
+		public:
+			ColumnParser()
+			{
+				if constexpr (!HasTryTraits<T>)
+					m_converter = findConverter(std::type_index(typeid(T)), true);
+			}
+
+			std::expected<T, ConvertError> parse(std::string_view field) const
+			{
+				if constexpr (HasTryTraits<T>)
+				{
+					return Traits<T>::tryFromChars(field);
+				}
+				else
+				{
+					if (!m_converter)
+						return std::unexpected(ConvertError::NoConverter);
+
+					auto result = tryGetAnyUsingConverter(*m_converter, field);
+					if (!result)
+						return std::unexpected(result.error());
+					return takeConverterResult<T>(*m_converter, *result);
+				}
+			}
+
+		private:
+			const ConverterInfo* m_converter = nullptr;
+		};
+	}
+
+	template<typename... Ts>
+	class BulkReader
+	{
+	public:
+		using Columns = std::tuple<std::vector<Ts>...>;
+
+		explicit BulkReader(std::istream& stream, const BulkOptions& options = BulkOptions())
+			: m_splitter(stream, options)
+		{
+		}
+
+		explicit BulkReader(std::string_view data, const BulkOptions& options = BulkOptions())
+			: m_splitter(data, options)
+		{
+		}
+
+		// Parses up to maxRows rows into columns, replacing their contents (their capacity is reused)
+		// Returns the number of rows read, 0 at the end of the input, or the first bad field.
+		// On error the columns hold the rows before the bad one.
+		std::expected<std::size_t, BulkError> read(Columns& columns, std::size_t maxRows)
+		{
+			std::apply([maxRows](auto&... column) { (prepareColumn(column, maxRows), ...); }, columns);
+
+			std::size_t rows = 0;
+			while (rows < maxRows && m_splitter.nextRow(m_fields))
+			{
+				if (m_fields.size() != sizeof...(Ts))
+					return std::unexpected(BulkError{ m_splitter.getLine(), sizeof...(Ts), ConvertError::InvalidSyntax });
+
+				BulkError error{ m_splitter.getLine(), 0, ConvertError::InvalidSyntax };
+				if (!parseRow(columns, error, std::index_sequence_for<Ts...>()))
+				{
+					std::apply([rows](auto&... column) { (column.resize(rows), ...); }, columns);
+					return std::unexpected(error);
+				}
+
+				rows++;
+			}
+
+			return rows;
+		}
+
+		// Parses the rest of the input into columns
+		std::expected<std::size_t, BulkError> readAll(Columns& columns)
+		{
+			return read(columns, static_cast<std::size_t>(-1));
+		}
+
+	private:
+		template<typename T>
+		static void prepareColumn(std::vector<T>& column, std::size_t maxRows)
+		{
+			column.clear();
+			if (maxRows != static_cast<std::size_t>(-1))
+				column.reserve(maxRows);
+		}
+
+		template<std::size_t... Is>
+		bool parseRow(Columns& columns, BulkError& error, std::index_sequence<Is...>)
+		{
+			return (parseField<Is>(columns, error) && ...);
+		}
+
+		template<std::size_t I>
+		bool parseField(Columns& columns, BulkError& error)
+		{
+			auto value = std::get<I>(m_parsers).parse(m_fields[I]);
+			if (!value)
+			{
+				error.column = I;
+				error.error = value.error();
+				return false;
+			}
+
+			std::get<I>(columns).push_back(std::move(*value));
+			return true;
+		}
+
+		RowSplitter m_splitter;
+		std::tuple<Impl::ColumnParser<Ts>...> m_parsers;
+		std::vector<std::string_view> m_fields;
+	};
+}
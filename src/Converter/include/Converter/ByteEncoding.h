@@ -0,0 +1,220 @@
+#pragma once
+
+#include <Converter/Bytes.h>
+#include <Converter/ConvertError.h>
+#include <Converter/ConverterExport.h>
+#include <Converter/OutputBuffer.h>
+#include <Converter/Traits.h>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Text forms of binary data such as hashes, keys and blobs
+// std::vector<std::byte> and std::array<std::byte, N> are converted as hex. Wrap any byte container
+// (of std::byte or std::uint8_t) in Converter::Hex or Converter::Base64 to pick the encoding:
+//
+//    struct Record
+//    {
+//        Converter::Hex<std::array<std::uint8_t, 32>> hash;     // "9f86d081..."
+//        Converter::Base64<std::vector<std::byte>> payload;     // "aGVsbG8="
+//    };
+//
+// Plain std::uint8_t containers keep the number list form of CompositeTraits.h ("[1,2,3]").
+//
+// Hex:    two digits per byte, written in lower case; upper case digits are accepted when parsing
+// Base64: the standard alphabet of RFC 4648 with '=' padding
+// Parsing is strict: no whitespace, base64 padding is required and its unused bits must be zero,
+// so every byte string has exactly one base64 form. Fixed size arrays require exactly N bytes.
+//
+// Whole buffers can be converted directly with encodeBytes / decodeBytes. Both use SSE4.1 kernels
+// when the CPU has them (checked once at runtime) and lookup tables otherwise.
+namespace Converter
+{
+	enum class ByteEncoding
+	{
+		Hex,
+		Base64,
+	};
+
+	// Length of the text form of byteCount bytes
+	constexpr std::size_t getEncodedSize(ByteEncoding encoding, std::size_t byteCount)
+	{
+		return encoding == ByteEncoding::Hex ? byteCount * 2 : (byteCount + 2) / 3 * 4;
+	}
+
+	// Number of bytes a text of textSize characters decodes to at most; exact for hex and unpadded base64
+	constexpr std::size_t getMaxDecodedSize(ByteEncoding encoding, std::size_t textSize)
+	{
+		return encoding == ByteEncoding::Hex ? textSize / 2 : textSize / 4 * 3;
+	}
+
+	// Appends the text form of bytes to out
+	CONVERTER_EXPORT void encodeBytes(ByteEncoding encoding, std::span<const std::byte> bytes, OutputBuffer& out);
+
+	// Decodes all of str into the front of out without throwing
+	// Returns the number of bytes written
+	// Errors: InvalidSyntax for a bad character, length or padding, OutOfRange if out is too small
+	CONVERTER_EXPORT std::expected<std::size_t, ConvertError> decodeBytes(ByteEncoding encoding, std::string_view str, std::span<std::byte> out);
+
+	namespace Impl
+	{
+		template<typename T>
+		inline constexpr bool c_isByte = std::same_as<T, std::byte> || std::same_as<T, std::uint8_t>;
+
+		template<typename T>
+		inline constexpr bool c_isByteVector = false;
+
+		template<typename T, typename Allocator>
+		inline constexpr bool c_isByteVector<std::vector<T, Allocator>> = c_isByte<T>;
+
+		template<typename T>
+		inline constexpr bool c_isByteArray = false;
+
+		template<typename T, std::size_t N>
+		inline constexpr bool c_isByteArray<std::array<T, N>> = c_isByte<T>;
+	}
+
+	// Containers that can be converted as bytes: std::vector and std::array of std::byte or std::uint8_t
+	template<typename T>
+	concept ByteContainer = Impl::c_isByteVector<T> || Impl::c_isByteArray<T>;
+
+	// Selects the encoding of a byte container; see Hex and Base64
+	template<ByteContainer T, ByteEncoding E>
+	struct EncodedBytes
+	{
+		T bytes{};
+
+		bool operator==(const EncodedBytes&) const = default;
+	};
+
+	template<ByteContainer T>
+	using Hex = EncodedBytes<T, ByteEncoding::Hex>;
+
+	template<ByteContainer T>
+	using Base64 = EncodedBytes<T, ByteEncoding::Base64>;
+
+	namespace Impl
+	{
+		// Traits of a byte container T written with encoding E
+		// Binary form: the raw bytes, preceded by a varint count for vectors
+		template<ByteContainer T, ByteEncoding E>
+		struct ByteTraits
+		{
+			static std::string toString(const T& val)
+			{
+				OutputBuffer out;
+				toChars(val, out);
+				return out.str();
+			}
+
+			static T fromString(const std::string& str)
+			{
+				return fromChars(str);
+			}
+
+			static void toChars(const T& val, OutputBuffer& out)
+			{
+				encodeBytes(E, std::as_bytes(std::span(val)), out);
+			}
+
+			static T fromChars(std::string_view str)
+			{
+				return valueOrLogError(tryFromChars(str), str, E == ByteEncoding::Hex ? "hex bytes" : "base64 bytes");
+			}
+
+			static std::expected<T, ConvertError> tryFromChars(std::string_view str)
+			{
+				T result{};
+				if constexpr (c_isByteArray<T>)
+				{
+					if (str.size() != getEncodedSize(E, result.size()))
+						return std::unexpected(ConvertError::InvalidSyntax);
+
+					auto size = decodeBytes(E, str, std::as_writable_bytes(std::span(result)));
+					if (!size)
+						return std::unexpected(size.error());
+					// Base64 with more padding than N needs decodes to fewer bytes
+					if (*size != result.size())
+						return std::unexpected(ConvertError::InvalidSyntax);
+				}
+				else
+				{
+					result.resize(getMaxDecodedSize(E, str.size()));
+					auto size = decodeBytes(E, str, std::as_writable_bytes(std::span(result)));
+					if (!size)
+						return std::unexpected(size.error());
+					result.resize(*size);
+				}
+				return result;
+			}
+
+			static void encode(const T& val, ByteWriter& out)
+			{
+				if constexpr (!c_isByteArray<T>)
+					out.writeVarint(val.size());
+				out.writeBytes(std::as_bytes(std::span(val)));
+			}
+
+			static std::expected<T, ConvertError> decode(ByteReader& in)
+			{
+				T result{};
+				std::uint64_t size = result.size();
+				if constexpr (!c_isByteArray<T>)
+				{
+					if (!in.readVarint(size))
+						return std::unexpected(ConvertError::UnexpectedEnd);
+				}
+
+				std::span<const std::byte> bytes;
+				if (!in.readBytes(size, bytes))
+					return std::unexpected(ConvertError::UnexpectedEnd);
+
+				if constexpr (!c_isByteArray<T>)
+					result.resize(bytes.size());
+				std::ranges::copy(bytes, std::as_writable_bytes(std::span(result)).begin());
+				return result;
+			}
+		};
+	}
+
+	template<typename Allocator>
+	struct Traits<std::vector<std::byte, Allocator>> : Impl::ByteTraits<std::vector<std::byte, Allocator>, ByteEncoding::Hex>
+	{
+	};
+
+	template<std::size_t N>
+	struct Traits<std::array<std::byte, N>> : Impl::ByteTraits<std::array<std::byte, N>, ByteEncoding::Hex>
+	{
+	};
+
+	template<ByteContainer T, ByteEncoding E>
+	struct Traits<EncodedBytes<T, E>>
+	{
+		using Bytes = Impl::ByteTraits<T, E>;
+
+		static std::string toString(const EncodedBytes<T, E>& val) { return Bytes::toString(val.bytes); }
+		static EncodedBytes<T, E> fromString(const std::string& str) { return { Bytes::fromString(str) }; }
+		static void toChars(const EncodedBytes<T, E>& val, OutputBuffer& out) { Bytes::toChars(val.bytes, out); }
+		static EncodedBytes<T, E> fromChars(std::string_view str) { return { Bytes::fromChars(str) }; }
+		static std::expected<EncodedBytes<T, E>, ConvertError> tryFromChars(std::string_view str) { return wrap(Bytes::tryFromChars(str)); }
+		static void encode(const EncodedBytes<T, E>& val, ByteWriter& out) { Bytes::encode(val.bytes, out); }
+		static std::expected<EncodedBytes<T, E>, ConvertError> decode(ByteReader& in) { return wrap(Bytes::decode(in)); }
+
+	private:
+		static std::expected<EncodedBytes<T, E>, ConvertError> wrap(std::expected<T, ConvertError> result)
+		{
+			if (!result)
+				return std::unexpected(result.error());
+			return EncodedBytes<T, E>{ std::move(*result) };
+		}
+	};
+}
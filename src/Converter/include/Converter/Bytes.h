@@ -0,0 +1,178 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace Converter
+{
+	// Caller owned byte buffer that binary converters append into
+	// Works like OutputBuffer: clear() keeps the capacity so a buffer can be reused without allocating.
+	//
+	// Multi-byte values are always written little-endian so the encoding is the same on every platform.
+	class ByteWriter
+	{
+	public:
+		ByteWriter() = default;
+		explicit ByteWriter(std::size_t capacity) { reserve(capacity); }
+
+		void writeBytes(std::span<const std::byte> bytes)
+		{
+			std::byte* dst = prepare(bytes.size());
+			std::copy(bytes.begin(), bytes.end(), dst);
+			commit(bytes.size());
+		}
+
+		void writeByte(std::byte byte)
+		{
+			*prepare(1) = byte;
+			commit(1);
+		}
+
+		// Fixed width little-endian integer or floating point value
+		template<typename T>
+			requires std::is_arithmetic_v<T>
+		void writeFixed(T val)
+		{
+			auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(val);
+			if constexpr (std::endian::native == std::endian::big)
+				std::reverse(bytes.begin(), bytes.end());
+			writeBytes(bytes);
+		}
+
+		// LEB128: 7 bits per byte, low bits first, high bit set on every byte but the last
+		void writeVarint(std::uint64_t val)
+		{
+			std::byte* dst = prepare(c_maxVarintSize);
+			std::size_t size = 0;
+			while (val >= 0x80)
+			{
+				dst[size++] = static_cast<std::byte>(val | 0x80);
+				val >>= 7;
+			}
+			dst[size++] = static_cast<std::byte>(val);
+			commit(size);
+		}
+
+		// Zigzag maps small negative numbers to small varints: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+		void writeSignedVarint(std::int64_t val)
+		{
+			writeVarint((static_cast<std::uint64_t>(val) << 1) ^ static_cast<std::uint64_t>(val >> 63));
+		}
+
+		// Returns space for at least n more bytes; only commit() makes them part of the buffer
+		std::byte* prepare(std::size_t n)
+		{
+			if (m_data.size() - m_size < n)
+				m_data.resize(std::max(m_size + n, m_data.size() * 2));
+			return m_data.data() + m_size;
+		}
+
+		void commit(std::size_t n) { m_size += n; }
+
+		void reserve(std::size_t capacity)
+		{
+			if (m_data.size() < capacity)
+				m_data.resize(capacity);
+		}
+
+		void clear() { m_size = 0; }
+		bool empty() const { return m_size == 0; }
+		std::size_t size() const { return m_size; }
+		std::span<const std::byte> bytes() const { return std::span<const std::byte>(m_data.data(), m_size); }
+		std::vector<std::byte> vector() const { return std::vector<std::byte>(m_data.begin(), m_data.begin() + static_cast<std::ptrdiff_t>(m_size)); }
+
+		static constexpr std::size_t c_maxVarintSize = 10;
+
+	private:
+		// m_data.size() is the capacity; only the first m_size bytes are in use
+		std::vector<std::byte> m_data;
+		std::size_t m_size = 0;
+	};
+
+	// Reads values written by a ByteWriter from the front of a byte span
+	// Every read returns false, without consuming anything, if there aren't enough bytes left.
+	class ByteReader
+	{
+	public:
+		explicit ByteReader(std::span<const std::byte> bytes)
+			: m_bytes(bytes)
+		{
+		}
+
+		bool readBytes(std::size_t n, std::span<const std::byte>& out)
+		{
+			if (m_bytes.size() < n)
+				return false;
+			out = m_bytes.first(n);
+			m_bytes = m_bytes.subspan(n);
+			return true;
+		}
+
+		bool readByte(std::byte& out)
+		{
+			if (m_bytes.empty())
+				return false;
+			out = m_bytes.front();
+			m_bytes = m_bytes.subspan(1);
+			return true;
+		}
+
+		template<typename T>
+			requires std::is_arithmetic_v<T>
+		bool readFixed(T& out)
+		{
+			std::span<const std::byte> bytes;
+			if (!readBytes(sizeof(T), bytes))
+				return false;
+
+			std::array<std::byte, sizeof(T)> value;
+			std::copy(bytes.begin(), bytes.end(), value.begin());
+			if constexpr (std::endian::native == std::endian::big)
+				std::reverse(value.begin(), value.end());
+			out = std::bit_cast<T>(value);
+			return true;
+		}
+
+		// Fails on a truncated varint or one longer than 64 bits
+		bool readVarint(std::uint64_t& out)
+		{
+			std::uint64_t val = 0;
+			for (std::size_t i = 0; i < m_bytes.size() && i < ByteWriter::c_maxVarintSize; i++)
+			{
+				const auto byte = static_cast<std::uint64_t>(m_bytes[i]);
+				// Only bit 0 of the last byte fits in 64 bits; anything more would be silently dropped
+				if (i == ByteWriter::c_maxVarintSize - 1 && byte > 1)
+					return false;
+				val |= (byte & 0x7f) << (7 * i);
+				if (!(byte & 0x80))
+				{
+					out = val;
+					m_bytes = m_bytes.subspan(i + 1);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool readSignedVarint(std::int64_t& out)
+		{
+			std::uint64_t val = 0;
+			if (!readVarint(val))
+				return false;
+			out = static_cast<std::int64_t>(val >> 1) ^ -static_cast<std::int64_t>(val & 1);
+			return true;
+		}
+
+		bool empty() const { return m_bytes.empty(); }
+		std::size_t remaining() const { return m_bytes.size(); }
+
+	private:
+		std::span<const std::byte> m_bytes;
+	};
+}
@@ -0,0 +1,365 @@
+#pragma once
+
+#include <Converter/Bytes.h>
+#include <Converter/ConvertError.h>
+#include <Converter/ConverterExport.h>
+#include <Converter/OutputBuffer.h>
+#include <Converter/Traits.h>
+
+#include <algorithm>
+#include <assert.h>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <numeric>
+#include <ratio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// ISO-8601 converters for std::chrono
+// Written and parsed by hand in a fixed layout; no locale, stream or time zone database is involved.
+//
+//    std::chrono::year_month_day                     2024-02-29
+//    std::chrono::sys_time<D>                        2024-02-29T13:45:07.123456789Z
+//    std::chrono::duration                           P1DT2H3M4.5S, -PT0.001S, P3W, PT0S
+//
+// Time points are UTC and written with as many fraction digits as their duration has (9 for
+// system_clock on most platforms, none for seconds). When parsing, 'T' may also be 't' or ' ',
+// 'Z' may be 'z' or an offset "+HH:MM" / "-HH:MM" and the fraction may have 1 to 9 digits after '.' or ','.
+// A time without a zone is UTC and a date on its own is midnight UTC.
+// Years outside 0000-9999 are written with a sign and parsed with an optional one ("+12345-01-01").
+//
+// Durations are written with the largest units first (days are 86400 s, as in std::chrono) and the
+// fraction without trailing zeros; week based durations are written in weeks. Parsing accepts the
+// same components in that order; months and years are calendar dependent and rejected.
+//
+// Parsing is exact: a value that can't be represented in the target type without losing precision,
+// or doesn't fit in it, is OutOfRange. So is a date that doesn't exist (2023-02-29) or a leap second.
+//
+// Supported durations have an integer count and a period of 10^-9 to 1 second, or a whole number of seconds
+// that divides a day, or one week. Use REGISTER_TRAITS_CONVERTER for types other than the built-in ones.
+namespace Converter
+{
+	namespace Impl
+	{
+		inline constexpr std::int64_t c_nanosPerSecond = 1000000000;
+		inline constexpr std::int64_t c_secondsPerDay = 86400;
+		inline constexpr std::int64_t c_secondsPerWeek = 7 * c_secondsPerDay;
+
+		constexpr bool isPowerOfTen(std::intmax_t val)
+		{
+			while (val > 1 && val % 10 == 0)
+				val /= 10;
+			return val == 1;
+		}
+
+		template<typename Period>
+		inline constexpr bool c_isDecimalSubsecond = Period::num == 1 && Period::den <= c_nanosPerSecond && isPowerOfTen(Period::den);
+
+		template<typename Period>
+		inline constexpr bool c_isWholeSeconds = Period::den == 1 && (c_secondsPerDay % Period::num == 0 || Period::num == c_secondsPerWeek);
+
+		// Number of decimal digits in the fraction of a second of Period
+		template<typename Period>
+		constexpr int getFractionDigits()
+		{
+			int digits = 0;
+			for (std::intmax_t den = Period::den; den > 1; den /= 10)
+				digits++;
+			return digits;
+		}
+
+		// UTC time since the epoch; nanoseconds is in [0, 1e9)
+		struct IsoTimestamp
+		{
+			std::int64_t seconds;
+			std::int64_t nanoseconds;
+		};
+
+		// Unsigned components of a duration
+		struct IsoDuration
+		{
+			bool negative = false;
+			std::uint64_t weeks = 0;
+			std::uint64_t days = 0;
+			std::uint64_t hours = 0;
+			std::uint64_t minutes = 0;
+			std::uint64_t seconds = 0;
+			std::uint64_t nanoseconds = 0; // Below 1e9
+		};
+
+		// Writes nothing and returns false if !date.ok()
+		CONVERTER_EXPORT bool writeIsoDate(const std::chrono::year_month_day& date, OutputBuffer& out);
+		CONVERTER_EXPORT std::expected<std::chrono::year_month_day, ConvertError> readIsoDate(std::string_view str);
+		// Writes fractionDigits (0-9) digits of nanoseconds
+		CONVERTER_EXPORT void writeIsoTimestamp(const IsoTimestamp& timestamp, int fractionDigits, OutputBuffer& out);
+		CONVERTER_EXPORT std::expected<IsoTimestamp, ConvertError> readIsoTimestamp(std::string_view str);
+		CONVERTER_EXPORT void writeIsoDuration(const IsoDuration& duration, OutputBuffer& out);
+		CONVERTER_EXPORT std::expected<IsoDuration, ConvertError> readIsoDuration(std::string_view str);
+
+		// val * factor + add without overflowing limit
+		inline bool mulAddChecked(std::uint64_t val, std::uint64_t factor, std::uint64_t add, std::uint64_t limit, std::uint64_t& result)
+		{
+			if (factor != 0 && val > (limit - std::min(add, limit)) / factor)
+				return false;
+			result = val * factor + add;
+			return result <= limit;
+		}
+
+		template<typename Rep>
+		std::uint64_t getMagnitude(Rep count, bool& negative)
+		{
+			negative = count < 0;
+			return negative ? std::uint64_t(0) - static_cast<std::uint64_t>(count) : static_cast<std::uint64_t>(count);
+		}
+
+		// Largest magnitude of a Rep with the given sign
+		template<typename Rep>
+		std::uint64_t getMagnitudeLimit(bool negative)
+		{
+			return static_cast<std::uint64_t>(std::numeric_limits<Rep>::max()) + (negative && std::is_signed_v<Rep> ? 1 : 0);
+		}
+
+		template<typename Rep>
+		std::expected<Rep, ConvertError> fromMagnitude(std::uint64_t magnitude, bool negative)
+		{
+			if (magnitude > getMagnitudeLimit<Rep>(negative) || (negative && !std::is_signed_v<Rep> && magnitude != 0))
+				return std::unexpected(ConvertError::OutOfRange);
+			return negative ? static_cast<Rep>(std::uint64_t(0) - magnitude) : static_cast<Rep>(magnitude);
+		}
+
+		// Adds value units of unitSeconds seconds to a count of Period, if that is exact
+		template<typename Period>
+		bool addDurationComponent(std::uint64_t value, std::uint64_t unitSeconds, std::uint64_t limit, std::uint64_t& count)
+		{
+			if constexpr (Period::den > 1)
+			{
+				return mulAddChecked(value, unitSeconds * Period::den, count, limit, count);
+			}
+			else
+			{
+				const std::uint64_t num = static_cast<std::uint64_t>(Period::num);
+				const std::uint64_t divisor = std::gcd(num, unitSeconds);
+				if (value % (num / divisor) != 0)
+					return false;
+				return mulAddChecked(value / (num / divisor), unitSeconds / divisor, count, limit, count);
+			}
+		}
+
+		// Shared traits of the chrono types; Derived provides write and read
+		template<typename T, typename Derived>
+		struct ChronoTraitsBase
+		{
+			static std::string toString(const T& val)
+			{
+				OutputBuffer out;
+				Derived::toChars(val, out);
+				return out.str();
+			}
+
+			static T fromString(const std::string& str)
+			{
+				return fromChars(str);
+			}
+
+			static T fromChars(std::string_view str)
+			{
+				return valueOrLogError(Derived::tryFromChars(str), str, "an ISO-8601 value");
+			}
+		};
+	}
+
+	template<typename T>
+	concept IsoDurationType = std::integral<typename T::rep>
+		&& (Impl::c_isDecimalSubsecond<typename T::period> || Impl::c_isWholeSeconds<typename T::period>);
+
+	template<typename Rep, typename Period>
+		requires IsoDurationType<std::chrono::duration<Rep, Period>>
+	struct Traits<std::chrono::duration<Rep, Period>> : Impl::ChronoTraitsBase<std::chrono::duration<Rep, Period>, Traits<std::chrono::duration<Rep, Period>>>
+	{
+		using Duration = std::chrono::duration<Rep, Period>;
+
+		static void toChars(const Duration& val, OutputBuffer& out)
+		{
+			Impl::IsoDuration duration;
+			std::uint64_t magnitude = Impl::getMagnitude(val.count(), duration.negative);
+			std::uint64_t secondsOfDay = 0;
+			if constexpr (Period::den == 1 && Period::num == Impl::c_secondsPerWeek)
+			{
+				duration.weeks = magnitude;
+			}
+			else if constexpr (Period::den == 1)
+			{
+				constexpr std::uint64_t c_perDay = Impl::c_secondsPerDay / Period::num;
+				duration.days = magnitude / c_perDay;
+				secondsOfDay = magnitude % c_perDay * Period::num;
+			}
+			else
+			{
+				const std::uint64_t seconds = magnitude / Period::den;
+				duration.nanoseconds = magnitude % Period::den * (Impl::c_nanosPerSecond / Period::den);
+				duration.days = seconds / Impl::c_secondsPerDay;
+				secondsOfDay = seconds % Impl::c_secondsPerDay;
+			}
+			duration.hours = secondsOfDay / 3600;
+			duration.minutes = secondsOfDay / 60 % 60;
+			duration.seconds = secondsOfDay % 60;
+			Impl::writeIsoDuration(duration, out);
+		}
+
+		static std::expected<Duration, ConvertError> tryFromChars(std::string_view str)
+		{
+			auto duration = Impl::readIsoDuration(str);
+			if (!duration)
+				return std::unexpected(duration.error());
+
+			const std::uint64_t limit = Impl::getMagnitudeLimit<Rep>(duration->negative);
+			std::uint64_t count = 0;
+			bool exact = Impl::addDurationComponent<Period>(duration->weeks, Impl::c_secondsPerWeek, limit, count)
+				&& Impl::addDurationComponent<Period>(duration->days, Impl::c_secondsPerDay, limit, count)
+				&& Impl::addDurationComponent<Period>(duration->hours, 3600, limit, count)
+				&& Impl::addDurationComponent<Period>(duration->minutes, 60, limit, count)
+				&& Impl::addDurationComponent<Period>(duration->seconds, 1, limit, count);
+
+			constexpr std::uint64_t c_nanosPerTick = Period::den > 1 ? Impl::c_nanosPerSecond / Period::den : Impl::c_nanosPerSecond;
+			exact = exact && duration->nanoseconds % c_nanosPerTick == 0 && Impl::mulAddChecked(count, 1, duration->nanoseconds / c_nanosPerTick, limit, count);
+			if (!exact)
+				return std::unexpected(ConvertError::OutOfRange);
+
+			auto rep = Impl::fromMagnitude<Rep>(count, duration->negative);
+			if (!rep)
+				return std::unexpected(rep.error());
+			return Duration(*rep);
+		}
+
+		// Binary: the count as a (zigzag) varint
+		static void encode(const Duration& val, ByteWriter& out)
+		{
+			Traits<Rep>::encode(val.count(), out);
+		}
+
+		static std::expected<Duration, ConvertError> decode(ByteReader& in)
+		{
+			auto count = Traits<Rep>::decode(in);
+			if (!count)
+				return std::unexpected(count.error());
+			return Duration(*count);
+		}
+	};
+
+	template<typename Duration>
+		requires std::integral<typename Duration::rep> && Impl::c_isDecimalSubsecond<typename Duration::period>
+	struct Traits<std::chrono::sys_time<Duration>> : Impl::ChronoTraitsBase<std::chrono::sys_time<Duration>, Traits<std::chrono::sys_time<Duration>>>
+	{
+		using TimePoint = std::chrono::sys_time<Duration>;
+		using Rep = typename Duration::rep;
+		using Period = typename Duration::period;
+
+		static void toChars(const TimePoint& val, OutputBuffer& out)
+		{
+			// Floor to whole seconds so the fraction is never negative
+			const std::int64_t count = static_cast<std::int64_t>(val.time_since_epoch().count());
+			std::int64_t seconds = count / Period::den;
+			std::int64_t ticks = count % Period::den;
+			if (ticks < 0)
+			{
+				seconds--;
+				ticks += Period::den;
+			}
+			Impl::writeIsoTimestamp(Impl::IsoTimestamp{ seconds, ticks * (Impl::c_nanosPerSecond / Period::den) }, Impl::getFractionDigits<Period>(), out);
+		}
+
+		static std::expected<TimePoint, ConvertError> tryFromChars(std::string_view str)
+		{
+			auto timestamp = Impl::readIsoTimestamp(str);
+			if (!timestamp)
+				return std::unexpected(timestamp.error());
+
+			constexpr std::int64_t c_nanosPerTick = Impl::c_nanosPerSecond / Period::den;
+			if (timestamp->nanoseconds % c_nanosPerTick != 0)
+				return std::unexpected(ConvertError::OutOfRange);
+
+			// Times before the epoch are negative seconds plus a positive fraction, so their magnitude is seconds minus the fraction
+			bool negative = false;
+			const std::uint64_t seconds = Impl::getMagnitude(timestamp->seconds, negative);
+			const std::uint64_t ticks = static_cast<std::uint64_t>(timestamp->nanoseconds / c_nanosPerTick);
+			const std::uint64_t limit = Impl::getMagnitudeLimit<Rep>(negative);
+			std::uint64_t magnitude = 0;
+			if (negative)
+			{
+				if (!Impl::mulAddChecked(seconds, Period::den, 0, std::numeric_limits<std::uint64_t>::max(), magnitude))
+					return std::unexpected(ConvertError::OutOfRange);
+				magnitude -= ticks;
+			}
+			else if (!Impl::mulAddChecked(seconds, Period::den, ticks, limit, magnitude))
+			{
+				return std::unexpected(ConvertError::OutOfRange);
+			}
+
+			auto rep = Impl::fromMagnitude<Rep>(magnitude, negative);
+			if (!rep)
+				return std::unexpected(rep.error());
+			return TimePoint(Duration(*rep));
+		}
+
+		// Binary: the count since the epoch as a (zigzag) varint
+		static void encode(const TimePoint& val, ByteWriter& out)
+		{
+			Traits<Rep>::encode(val.time_since_epoch().count(), out);
+		}
+
+		static std::expected<TimePoint, ConvertError> decode(ByteReader& in)
+		{
+			auto count = Traits<Rep>::decode(in);
+			if (!count)
+				return std::unexpected(count.error());
+			return TimePoint(Duration(*count));
+		}
+	};
+
+	template<>
+	struct Traits<std::chrono::year_month_day> : Impl::ChronoTraitsBase<std::chrono::year_month_day, Traits<std::chrono::year_month_day>>
+	{
+		static void toChars(const std::chrono::year_month_day& val, OutputBuffer& out)
+		{
+			if (!Impl::writeIsoDate(val, out))
+			{
+				Log::Error().log("Unable to convert an invalid date to a string! Year {}, month {}, day {}",
+					static_cast<int>(val.year()), static_cast<unsigned>(val.month()), static_cast<unsigned>(val.day()));
+				assert(false && "Invalid date!");
+			}
+		}
+
+		static std::expected<std::chrono::year_month_day, ConvertError> tryFromChars(std::string_view str) { return Impl::readIsoDate(str); }
+
+		// Binary: (zigzag) varint year followed by one byte each for month and day
+		static void encode(const std::chrono::year_month_day& val, ByteWriter& out)
+		{
+			out.writeSignedVarint(static_cast<int>(val.year()));
+			out.writeByte(static_cast<std::byte>(static_cast<unsigned>(val.month())));
+			out.writeByte(static_cast<std::byte>(static_cast<unsigned>(val.day())));
+		}
+
+		static std::expected<std::chrono::year_month_day, ConvertError> decode(ByteReader& in)
+		{
+			std::int64_t year = 0;
+			std::byte month{};
+			std::byte day{};
+			if (!in.readSignedVarint(year) || !in.readByte(month) || !in.readByte(day))
+				return std::unexpected(ConvertError::UnexpectedEnd);
+
+			if (year < static_cast<int>(std::chrono::year::min()) || year > static_cast<int>(std::chrono::year::max()))
+				return std::unexpected(ConvertError::OutOfRange);
+
+			const std::chrono::year_month_day date{ std::chrono::year(static_cast<int>(year)),
+				std::chrono::month(static_cast<unsigned>(month)), std::chrono::day(static_cast<unsigned>(day)) };
+			if (!date.ok())
+				return std::unexpected(ConvertError::OutOfRange);
+			return date;
+		}
+	};
+}
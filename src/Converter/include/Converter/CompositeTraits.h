@@ -0,0 +1,768 @@
+#pragma once
+
+#include <Converter/Bytes.h>
+#include <Converter/ConvertError.h>
+#include <Converter/OutputBuffer.h>
+#include <Converter/Traits.h>
+
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <cstddef>
+#include <expected>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// Converters for standard composite types
+// Traits are provided for std::vector, std::array, std::map, std::unordered_map, std::optional,
+// std::pair, std::tuple and std::variant whenever all of their element types are Composable
+// (have chars and try traits, including other composites). They nest to any depth.
+//
+// Grammar (no whitespace is written; spaces and tabs between tokens are skipped when parsing):
+//
+//    value    := sequence | map | tuple | variant | optional | leaf
+//    sequence := '[' [value {',' value}] ']'                std::vector, std::array (exactly N values)
+//    map      := '{' [value ':' value {',' value ':' value}] '}'
+//    tuple    := '(' [value {',' value}] ')'                std::pair, std::tuple
+//    variant  := index ':' value                            index of the held alternative
+//    optional := 'null' | value
+//    leaf     := number | bool | enum | quoted
+//    quoted   := '"' {character | '\"' | '\\'} '"'
+//
+// Numbers, bools and enums are written bare. Every other leaf (std::string, char and user types) is written
+// with its own converter and quoted, so leaf text can never be confused with the structure.
+// Example: std::map<std::string, std::vector<int>> -> {"a":[1,2],"b":[]}
+//
+// An engaged optional holding a disengaged optional is written as null and reads back as disengaged.
+//
+// When every element type has a binary encoding the composite has one too:
+//    sequence: varint count (std::vector only) followed by the elements
+//    map:      varint count followed by key, value pairs
+//    tuple:    the elements in order
+//    optional: one byte 0 / 1 followed by the value if engaged
+//    variant:  varint index followed by the held value
+namespace Converter
+{
+	// Types that can be nested inside a composite
+	template<typename T>
+	concept Composable = HasCharsTraits<T> && HasTryTraits<T>;
+
+	namespace Impl
+	{
+		// Composite traits additionally parse a value from the front of a string and leave the rest
+		template<typename T>
+		concept CompositeTraits = requires(const T& val, std::string_view& rest, OutputBuffer& out)
+		{
+			{ Traits<T>::read(rest) } -> std::same_as<std::expected<T, ConvertError>>;
+			{ Traits<T>::write(val, out) } -> std::same_as<void>;
+			{ Traits<T>::sizeHint(val) } -> std::same_as<std::size_t>;
+		};
+
+		// Leaves that are written without quotes
+		template<typename T>
+		concept BareLeaf = (std::is_arithmetic_v<T> || std::is_enum_v<T>) && !CharacterType<T>;
+
+		// Rough output size of a bare leaf, only used to reserve space
+		inline constexpr std::size_t c_bareLeafSizeHint = 8;
+
+		inline bool isSpace(char c)
+		{
+			return c == ' ' || c == '\t';
+		}
+
+		inline void skipSpaces(std::string_view& rest)
+		{
+			while (!rest.empty() && isSpace(rest.front()))
+				rest.remove_prefix(1);
+		}
+
+		// Consumes c (after any spaces) if it is next
+		inline bool consume(std::string_view& rest, char c)
+		{
+			skipSpaces(rest);
+			if (rest.empty() || rest.front() != c)
+				return false;
+			rest.remove_prefix(1);
+			return true;
+		}
+
+		inline bool isDelimiter(char c)
+		{
+			return c == ',' || c == ':' || c == ']' || c == '}' || c == ')' || isSpace(c);
+		}
+
+		// Takes the text of a bare leaf off the front of rest
+		inline std::string_view readToken(std::string_view& rest)
+		{
+			std::size_t size = 0;
+			while (size < rest.size() && !isDelimiter(rest[size]))
+				size++;
+
+			std::string_view token = rest.substr(0, size);
+			rest.remove_prefix(size);
+			return token;
+		}
+
+		inline void writeQuoted(std::string_view str, OutputBuffer& out)
+		{
+			out.push_back('"');
+			while (!str.empty())
+			{
+				const std::size_t special = str.find_first_of("\"\\");
+				out.append(str.substr(0, special));
+				if (special == std::string_view::npos)
+					break;
+
+				out.push_back('\\');
+				out.push_back(str[special]);
+				str.remove_prefix(special + 1);
+			}
+			out.push_back('"');
+		}
+
+		inline std::expected<std::string, ConvertError> readQuoted(std::string_view& rest)
+		{
+			if (!consume(rest, '"'))
+				return std::unexpected(ConvertError::InvalidSyntax);
+
+			std::string result;
+			while (true)
+			{
+				const std::size_t special = rest.find_first_of("\"\\");
+				if (special == std::string_view::npos || (rest[special] == '\\' && special + 1 == rest.size()))
+					return std::unexpected(ConvertError::InvalidSyntax);
+
+				result.append(rest.substr(0, special));
+				if (rest[special] == '"')
+				{
+					rest.remove_prefix(special + 1);
+					return result;
+				}
+
+				const char escaped = rest[special + 1];
+				if (escaped != '"' && escaped != '\\')
+					return std::unexpected(ConvertError::InvalidSyntax);
+
+				result.push_back(escaped);
+				rest.remove_prefix(special + 2);
+			}
+		}
+
+		template<typename T>
+		std::size_t elementSizeHint(const T& val)
+		{
+			if constexpr (CompositeTraits<T>)
+				return Traits<T>::sizeHint(val);
+			else if constexpr (std::same_as<T, std::string>)
+				return val.size() + 2;
+			else
+				return c_bareLeafSizeHint;
+		}
+
+		template<typename T>
+		void writeElement(const T& val, OutputBuffer& out)
+		{
+			if constexpr (CompositeTraits<T>)
+			{
+				Traits<T>::write(val, out);
+			}
+			else if constexpr (BareLeaf<T>)
+			{
+				Traits<T>::toChars(val, out);
+			}
+			else if constexpr (std::same_as<T, std::string>)
+			{
+				writeQuoted(val, out);
+			}
+			else if constexpr (std::same_as<T, char>)
+			{
+				writeQuoted(std::string_view(&val, 1), out);
+			}
+			else
+			{
+				OutputBuffer text;
+				Traits<T>::toChars(val, text);
+				writeQuoted(text.view(), out);
+			}
+		}
+
+		template<typename T>
+		std::expected<T, ConvertError> readElement(std::string_view& rest)
+		{
+			skipSpaces(rest);
+			if constexpr (CompositeTraits<T>)
+			{
+				return Traits<T>::read(rest);
+			}
+			else if constexpr (BareLeaf<T>)
+			{
+				return Traits<T>::tryFromChars(readToken(rest));
+			}
+			else
+			{
+				auto text = readQuoted(rest);
+				if (!text)
+					return std::unexpected(text.error());
+
+				if constexpr (std::same_as<T, std::string>)
+					return std::move(*text);
+				else
+					return Traits<T>::tryFromChars(*text);
+			}
+		}
+
+		// Provides the public traits interface of a composite from its write / read / sizeHint
+		template<typename T>
+		struct CompositeTraitsBase
+		{
+			static std::string toString(const T& val)
+			{
+				OutputBuffer out;
+				toChars(val, out);
+				return out.str();
+			}
+
+			static T fromString(const std::string& str)
+			{
+				return fromChars(str);
+			}
+
+			static void toChars(const T& val, OutputBuffer& out)
+			{
+				// Reserve once for the whole value; the nested writes only append
+				out.reserve(out.size() + Traits<T>::sizeHint(val));
+				Traits<T>::write(val, out);
+			}
+
+			static T fromChars(std::string_view str)
+			{
+				return valueOrLogError(tryFromChars(str), str, "a composite value");
+			}
+
+			static std::expected<T, ConvertError> tryFromChars(std::string_view str)
+			{
+				auto result = Traits<T>::read(str);
+				if (result)
+				{
+					skipSpaces(str);
+					if (!str.empty())
+						return std::unexpected(ConvertError::TrailingCharacters);
+				}
+				return result;
+			}
+		};
+
+		// Shared by std::vector and std::array; only reading differs
+		// FixedSize sequences don't write their element count in binary
+		template<typename T, bool FixedSize>
+		struct SequenceTraits : CompositeTraitsBase<T>
+		{
+			using Element = typename T::value_type;
+
+			static std::size_t sizeHint(const T& val)
+			{
+				if constexpr (BareLeaf<Element>)
+				{
+					return 2 + val.size() * (c_bareLeafSizeHint + 1);
+				}
+				else
+				{
+					std::size_t size = 2;
+					for (const auto& element : val)
+						size += elementSizeHint(element) + 1;
+					return size;
+				}
+			}
+
+			static void encode(const T& val, ByteWriter& out)
+				requires HasBinaryTraits<Element>
+			{
+				if constexpr (!FixedSize)
+					out.writeVarint(val.size());
+				for (const auto& element : val)
+					Traits<Element>::encode(element, out);
+			}
+
+			static void write(const T& val, OutputBuffer& out)
+			{
+				out.push_back('[');
+				bool first = true;
+				for (const auto& element : val)
+				{
+					if (!first)
+						out.push_back(',');
+					first = false;
+					writeElement(element, out);
+				}
+				out.push_back(']');
+			}
+		};
+	}
+
+	template<Composable T, typename Allocator>
+	struct Traits<std::vector<T, Allocator>> : Impl::SequenceTraits<std::vector<T, Allocator>, false>
+	{
+		static std::expected<std::vector<T, Allocator>, ConvertError> read(std::string_view& rest)
+		{
+			if (!Impl::consume(rest, '['))
+				return std::unexpected(ConvertError::InvalidSyntax);
+
+			std::vector<T, Allocator> result;
+			if (Impl::consume(rest, ']'))
+				return result;
+
+			do
+			{
+				auto element = Impl::readElement<T>(rest);
+				if (!element)
+					return std::unexpected(element.error());
+				result.push_back(std::move(*element));
+			} while (Impl::consume(rest, ','));
+
+			if (!Impl::consume(rest, ']'))
+				return std::unexpected(ConvertError::InvalidSyntax);
+
+			return result;
+		}
+
+		static std::expected<std::vector<T, Allocator>, ConvertError> decode(ByteReader& in)
+			requires HasBinaryTraits<T>
+		{
+			std::uint64_t count = 0;
+			if (!in.readVarint(count))
+				return std::unexpected(ConvertError::UnexpectedEnd);
+
+			std::vector<T, Allocator> result;
+			// Every element takes at least one byte; don't trust a corrupt count for the reservation
+			result.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(count, in.remaining())));
+			for (std::uint64_t i = 0; i < count; i++)
+			{
+				auto element = Traits<T>::decode(in);
+				if (!element)
+					return std::unexpected(element.error());
+				result.push_back(std::move(*element));
+			}
+			return result;
+		}
+	};
+
+	template<Composable T, std::size_t N>
+	struct Traits<std::array<T, N>> : Impl::SequenceTraits<std::array<T, N>, true>
+	{
+		static std::expected<std::array<T, N>, ConvertError> read(std::string_view& rest)
+		{
+			if (!Impl::consume(rest, '['))
+				return std::unexpected(ConvertError::InvalidSyntax);
+
+			std::array<T, N> result{};
+			for (std::size_t i = 0; i < N; i++)
+			{
+				if (i > 0 && !Impl::consume(rest, ','))
+					return std::unexpected(ConvertError::InvalidSyntax);
+
+				auto element = Impl::readElement<T>(rest);
+				if (!element)
+					return std::unexpected(element.error());
+				result[i] = std::move(*element);
+			}
+
+			if (!Impl::consume(rest, ']'))
+				return std::unexpected(ConvertError::InvalidSyntax);
+
+			return result;
+		}
+
+		static std::expected<std::array<T, N>, ConvertError> decode(ByteReader& in)
+			requires HasBinaryTraits<T>
+		{
+			std::array<T, N> result{};
+			for (auto& element : result)
+			{
+				auto decoded = Traits<T>::decode(in);
+				if (!decoded)
+					return std::unexpected(decoded.error());
+				element = std::move(*decoded);
+			}
+			return result;
+		}
+	};
+
+	namespace Impl
+	{
+		template<typename T>
+		struct MapTraits : CompositeTraitsBase<T>
+		{
+			using Key = typename T::key_type;
+			using Value = typename T::mapped_type;
+
+			static std::size_t sizeHint(const T& val)
+			{
+				std::size_t size = 2;
+				for (const auto& [key, value] : val)
+					size += elementSizeHint(key) + elementSizeHint(value) + 2;
+				return size;
+			}
+
+			static void write(const T& val, OutputBuffer& out)
+			{
+				out.push_back('{');
+				bool first = true;
+				for (const auto& [key, value] : val)
+				{
+					if (!first)
+						out.push_back(',');
+					first = false;
+					writeElement(key, out);
+					out.push_back(':');
+					writeElement(value, out);
+				}
+				out.push_back('}');
+			}
+
+			static void encode(const T& val, ByteWriter& out)
+				requires HasBinaryTraits<Key> && HasBinaryTraits<Value>
+			{
+				out.writeVarint(val.size());
+				for (const auto& [key, value] : val)
+				{
+					Traits<Key>::encode(key, out);
+					Traits<Value>::encode(value, out);
+				}
+			}
+
+			static std::expected<T, ConvertError> decode(ByteReader& in)
+				requires HasBinaryTraits<Key> && HasBinaryTraits<Value>
+			{
+				std::uint64_t count = 0;
+				if (!in.readVarint(count))
+					return std::unexpected(ConvertError::UnexpectedEnd);
+
+				T result;
+				for (std::uint64_t i = 0; i < count; i++)
+				{
+					auto key = Traits<Key>::decode(in);
+					if (!key)
+						return std::unexpected(key.error());
+					auto value = Traits<Value>::decode(in);
+					if (!value)
+						return std::unexpected(value.error());
+
+					if (!result.try_emplace(std::move(*key), std::move(*value)).second)
+						return std::unexpected(ConvertError::InvalidSyntax);
+				}
+				return result;
+			}
+
+			// Duplicate keys are a syntax error
+			static std::expected<T, ConvertError> read(std::string_view& rest)
+			{
+				if (!consume(rest, '{'))
+					return std::unexpected(ConvertError::InvalidSyntax);
+
+				T result;
+				if (consume(rest, '}'))
+					return result;
+
+				do
+				{
+					auto key = readElement<Key>(rest);
+					if (!key)
+						return std::unexpected(key.error());
+					if (!consume(rest, ':'))
+						return std::unexpected(ConvertError::InvalidSyntax);
+
+					auto value = readElement<Value>(rest);
+					if (!value)
+						return std::unexpected(value.error());
+
+					if (!result.try_emplace(std::move(*key), std::move(*value)).second)
+						return std::unexpected(ConvertError::InvalidSyntax);
+				} while (consume(rest, ','));
+
+				if (!consume(rest, '}'))
+					return std::unexpected(ConvertError::InvalidSyntax);
+
+				return result;
+			}
+		};
+
+		template<typename T, typename = std::make_index_sequence<std::tuple_size_v<T>>>
+		inline constexpr bool c_tupleHasBinaryTraits = false;
+
+		template<typename T, std::size_t... Is>
+		inline constexpr bool c_tupleHasBinaryTraits<T, std::index_sequence<Is...>> = (HasBinaryTraits<std::tuple_element_t<Is, T>> && ...);
+
+		template<typename T>
+		concept TupleHasBinaryTraits = c_tupleHasBinaryTraits<T>;
+
+		// Shared by std::pair and std::tuple through std::get / std::tuple_size
+		template<typename T>
+		struct TupleTraits : CompositeTraitsBase<T>
+		{
+			static std::size_t sizeHint(const T& val)
+			{
+				return std::apply([](const auto&... elements) { return (std::size_t(2) + ... + (elementSizeHint(elements) + 1)); }, val);
+			}
+
+			static void write(const T& val, OutputBuffer& out)
+			{
+				out.push_back('(');
+				std::apply([&out](const auto&... elements)
+					{
+						bool first = true;
+						((first ? void() : out.push_back(','), first = false, writeElement(elements, out)), ...);
+					}, val);
+				out.push_back(')');
+			}
+
+			static std::expected<T, ConvertError> read(std::string_view& rest)
+			{
+				if (!consume(rest, '('))
+					return std::unexpected(ConvertError::InvalidSyntax);
+
+				T result{};
+				ConvertError error = ConvertError::InvalidSyntax;
+				if (!readElements(rest, result, error, std::make_index_sequence<std::tuple_size_v<T>>()))
+					return std::unexpected(error);
+
+				if (!consume(rest, ')'))
+					return std::unexpected(ConvertError::InvalidSyntax);
+
+				return result;
+			}
+
+			static void encode(const T& val, ByteWriter& out)
+				requires TupleHasBinaryTraits<T>
+			{
+				std::apply([&out](const auto&... elements) { (Traits<std::remove_cvref_t<decltype(elements)>>::encode(elements, out), ...); }, val);
+			}
+
+			static std::expected<T, ConvertError> decode(ByteReader& in)
+				requires TupleHasBinaryTraits<T>
+			{
+				T result{};
+				ConvertError error = ConvertError::UnexpectedEnd;
+				if (!decodeElements(in, result, error, std::make_index_sequence<std::tuple_size_v<T>>()))
+					return std::unexpected(error);
+				return result;
+			}
+
+		private:
+			template<std::size_t... Is>
+			static bool decodeElements(ByteReader& in, T& result, ConvertError& error, std::index_sequence<Is...>)
+			{
+				return (decodeElementAt<Is>(in, result, error) && ...);
+			}
+
+			template<std::size_t I>
+			static bool decodeElementAt(ByteReader& in, T& result, ConvertError& error)
+			{
+				auto element = Traits<std::tuple_element_t<I, T>>::decode(in);
+				if (!element)
+				{
+					error = element.error();
+					return false;
+				}
+
+				std::get<I>(result) = std::move(*element);
+				return true;
+			}
+
+			template<std::size_t... Is>
+			static bool readElements(std::string_view& rest, T& result, ConvertError& error, std::index_sequence<Is...>)
+			{
+				return (readElementAt<Is>(rest, result, error) && ...);
+			}
+
+			template<std::size_t I>
+			static bool readElementAt(std::string_view& rest, T& result, ConvertError& error)
+			{
+				if (I > 0 && !consume(rest, ','))
+					return false;
+
+				auto element = readElement<std::tuple_element_t<I, T>>(rest);
+				if (!element)
+				{
+					error = element.error();
+					return false;
+				}
+
+				std::get<I>(result) = std::move(*element);
+				return true;
+			}
+		};
+	}
+
+	template<Composable Key, Composable Value, typename Compare, typename Allocator>
+	struct Traits<std::map<Key, Value, Compare, Allocator>> : Impl::MapTraits<std::map<Key, Value, Compare, Allocator>>
+	{
+	};
+
+	template<Composable Key, Composable Value, typename Hash, typename KeyEqual, typename Allocator>
+	struct Traits<std::unordered_map<Key, Value, Hash, KeyEqual, Allocator>> : Impl::MapTraits<std::unordered_map<Key, Value, Hash, KeyEqual, Allocator>>
+	{
+	};
+
+	template<Composable First, Composable Second>
+	struct Traits<std::pair<First, Second>> : Impl::TupleTraits<std::pair<First, Second>>
+	{
+	};
+
+	template<Composable... Ts>
+	struct Traits<std::tuple<Ts...>> : Impl::TupleTraits<std::tuple<Ts...>>
+	{
+	};
+
+	template<Composable T>
+	struct Traits<std::optional<T>> : Impl::CompositeTraitsBase<std::optional<T>>
+	{
+		static constexpr std::string_view c_null = "null";
+
+		static std::size_t sizeHint(const std::optional<T>& val)
+		{
+			return val ? Impl::elementSizeHint(*val) : c_null.size();
+		}
+
+		static void write(const std::optional<T>& val, OutputBuffer& out)
+		{
+			if (val)
+				Impl::writeElement(*val, out);
+			else
+				out.append(c_null);
+		}
+
+		static std::expected<std::optional<T>, ConvertError> read(std::string_view& rest)
+		{
+			Impl::skipSpaces(rest);
+			if (rest.starts_with(c_null) && (rest.size() == c_null.size() || Impl::isDelimiter(rest[c_null.size()])))
+			{
+				rest.remove_prefix(c_null.size());
+				return std::optional<T>();
+			}
+
+			auto value = Impl::readElement<T>(rest);
+			if (!value)
+				return std::unexpected(value.error());
+
+			return std::optional<T>(std::move(*value));
+		}
+
+		static void encode(const std::optional<T>& val, ByteWriter& out)
+			requires HasBinaryTraits<T>
+		{
+			out.writeByte(std::byte(val ? 1 : 0));
+			if (val)
+				Traits<T>::encode(*val, out);
+		}
+
+		static std::expected<std::optional<T>, ConvertError> decode(ByteReader& in)
+			requires HasBinaryTraits<T>
+		{
+			std::byte engaged{};
+			if (!in.readByte(engaged))
+				return std::unexpected(ConvertError::UnexpectedEnd);
+			if (engaged == std::byte(0))
+				return std::optional<T>();
+			if (engaged != std::byte(1))
+				return std::unexpected(ConvertError::InvalidSyntax);
+
+			auto value = Traits<T>::decode(in);
+			if (!value)
+				return std::unexpected(value.error());
+			return std::optional<T>(std::move(*value));
+		}
+	};
+
+	template<Composable... Ts>
+	struct Traits<std::variant<Ts...>> : Impl::CompositeTraitsBase<std::variant<Ts...>>
+	{
+		static std::size_t sizeHint(const std::variant<Ts...>& val)
+		{
+			return std::visit([](const auto& held) { return Impl::elementSizeHint(held) + 4; }, val);
+		}
+
+		static void write(const std::variant<Ts...>& val, OutputBuffer& out)
+		{
+			Traits<std::size_t>::toChars(val.index(), out);
+			out.push_back(':');
+			std::visit([&out](const auto& held) { Impl::writeElement(held, out); }, val);
+		}
+
+		static std::expected<std::variant<Ts...>, ConvertError> read(std::string_view& rest)
+		{
+			Impl::skipSpaces(rest);
+			auto index = Traits<std::size_t>::tryFromChars(Impl::readToken(rest));
+			if (!index)
+				return std::unexpected(index.error());
+			if (*index >= sizeof...(Ts) || !Impl::consume(rest, ':'))
+				return std::unexpected(ConvertError::InvalidSyntax);
+
+			std::expected<std::variant<Ts...>, ConvertError> result = std::unexpected(ConvertError::InvalidSyntax);
+			readAlternative(rest, *index, result, std::index_sequence_for<Ts...>());
+			return result;
+		}
+
+		static void encode(const std::variant<Ts...>& val, ByteWriter& out)
+			requires (HasBinaryTraits<Ts> && ...)
+		{
+			out.writeVarint(val.index());
+			std::visit([&out](const auto& held) { Traits<std::remove_cvref_t<decltype(held)>>::encode(held, out); }, val);
+		}
+
+		static std::expected<std::variant<Ts...>, ConvertError> decode(ByteReader& in)
+			requires (HasBinaryTraits<Ts> && ...)
+		{
+			std::uint64_t index = 0;
+			if (!in.readVarint(index))
+				return std::unexpected(ConvertError::UnexpectedEnd);
+			if (index >= sizeof...(Ts))
+				return std::unexpected(ConvertError::InvalidSyntax);
+
+			std::expected<std::variant<Ts...>, ConvertError> result = std::unexpected(ConvertError::InvalidSyntax);
+			decodeAlternative(in, static_cast<std::size_t>(index), result, std::index_sequence_for<Ts...>());
+			return result;
+		}
+
+	private:
+		template<std::size_t... Is>
+		static void readAlternative(std::string_view& rest, std::size_t index, std::expected<std::variant<Ts...>, ConvertError>& result, std::index_sequence<Is...>)
+		{
+			((Is == index ? void(readAlternativeAt<Is>(rest, result)) : void()), ...);
+		}
+
+		template<std::size_t I>
+		static void readAlternativeAt(std::string_view& rest, std::expected<std::variant<Ts...>, ConvertError>& result)
+		{
+			auto value = Impl::readElement<std::variant_alternative_t<I, std::variant<Ts...>>>(rest);
+			if (value)
+				result = std::variant<Ts...>(std::in_place_index<I>, std::move(*value));
+			else
+				result = std::unexpected(value.error());
+		}
+
+		template<std::size_t... Is>
+		static void decodeAlternative(ByteReader& in, std::size_t index, std::expected<std::variant<Ts...>, ConvertError>& result, std::index_sequence<Is...>)
+		{
+			((Is == index ? void(decodeAlternativeAt<Is>(in, result)) : void()), ...);
+		}
+
+		template<std::size_t I>
+		static void decodeAlternativeAt(ByteReader& in, std::expected<std::variant<Ts...>, ConvertError>& result)
+		{
+			auto value = Traits<std::variant_alternative_t<I, std::variant<Ts...>>>::decode(in);
+			if (value)
+				result = std::variant<Ts...>(std::in_place_index<I>, std::move(*value));
+			else
+				result = std::unexpected(value.error());
+		}
+	};
+}
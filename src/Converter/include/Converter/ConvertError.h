@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string_view>
+
+namespace Converter
+{
+	// Reasons a string could not be converted to a value
+	// Returned by the non-throwing parse functions (see Converter::tryParse) and the binary decoders
+	enum class ConvertError
+	{
+		InvalidSyntax,      // The input does not start with a valid value
+		OutOfRange,         // The value does not fit in the target type
+		TrailingCharacters, // A valid value was followed by unparsed characters
+		NoConverter,        // No converter is registered for the type
+		UnexpectedEnd,      // Binary input ended before the value was complete
+		TypeMismatch,       // The registered converter returned a value of another type
+	};
+
+	// Returns a readable name for an error
+	constexpr std::string_view getStringForError(ConvertError error)
+	{
+		switch (error)
+		{
+		case ConvertError::InvalidSyntax:
+			return "invalid syntax";
+		case ConvertError::OutOfRange:
+			return "out of range";
+		case ConvertError::TrailingCharacters:
+			return "trailing characters";
+		case ConvertError::NoConverter:
+			return "no converter";
+		case ConvertError::UnexpectedEnd:
+			return "unexpected end of input";
+		case ConvertError::TypeMismatch:
+			return "type mismatch";
+		default:
+			break;
+		}
+
+		return "";
+	}
+}
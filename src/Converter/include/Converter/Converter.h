@@ -1,14 +1,30 @@
 #pragma once
 
+#include <Converter/ByteEncoding.h>
+#include <Converter/Bytes.h>
+#include <Converter/ChronoTraits.h>
+#include <Converter/CompositeTraits.h>
 #include <Converter/ConverterExport.h>
+#include <Converter/ConverterStats.h>
+#include <Converter/EnumTraits.h>
+#include <Converter/FormatSpec.h>
+#include <Converter/OutputBuffer.h>
+#include <Converter/SmallFunction.h>
+#include <Converter/Traits.h>
 
 #include <Logger/Logger.h>
 
 #include <typeindex>
+#include <typeinfo>
 #include <functional>
 #include <any>
+#include <stdexcept>
+#include <expected>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <format>
+#include <algorithm>
 #include <assert.h>
 
 // Register a global converter for a type
@@ -19,6 +35,42 @@
 #define REGISTER_CONVERTER(classname, toStringFunc, fromStringFunc) \
 	Converter::Impl::registerConverter<classname>(#classname, toStringFunc, fromStringFunc);
 
+// Register a global converter for a type that specializes Converter::Traits
+// This makes the compile time converter available to the type erased getStringFromAny functions
+// Composite types can be passed directly, e.g. REGISTER_TRAITS_CONVERTER(std::map<std::string, int>)
+// Only call this macro once per type.
+#define REGISTER_TRAITS_CONVERTER(...) \
+	Converter::Impl::registerTraitsConverter<__VA_ARGS__>(#__VA_ARGS__);
+
+// Register a global converter for an enum
+// The enum must have opted in to compile time traits with ENABLE_ENUM_CONVERTER (see EnumTraits.h);
+// this makes them available to the type erased functions as well
+// Only call this macro once per type.
+#define REGISTER_ENUM_CONVERTER(...) \
+	Converter::Impl::registerEnumConverter<__VA_ARGS__>(#__VA_ARGS__);
+
+// Register a global converter that also has a binary form
+// encodeFunc: void(const T&, Converter::ByteWriter&)
+// decodeFunc: std::expected<T, Converter::ConvertError>(Converter::ByteReader&)
+// Only call this macro once per type.
+#define REGISTER_BINARY_CONVERTER(classname, toStringFunc, fromStringFunc, encodeFunc, decodeFunc) \
+	Converter::Impl::registerBinaryConverter<classname>(#classname, toStringFunc, fromStringFunc, encodeFunc, decodeFunc);
+
+// Register a global converter from a non-allocating formatter and a non-throwing parser
+// toCharsFunc:      void(const T&, Converter::OutputBuffer&)
+// tryFromCharsFunc: std::expected<T, Converter::ConvertError>(std::string_view)
+// All other forms of the converter (string, string_view, tryParse) are built from these two
+// Only call this macro once per type.
+#define REGISTER_TRY_CONVERTER(classname, toCharsFunc, tryFromCharsFunc) \
+	Converter::Impl::registerTryConverter<classname>(#classname, toCharsFunc, tryFromCharsFunc);
+
+// Register a global converter that also has non-allocating forms
+// toCharsFunc appends to a Converter::OutputBuffer and fromCharsFunc parses a std::string_view
+// These are used by the OutputBuffer / string_view overloads; the plain string functions by everything else
+// Only call this macro once per type.
+#define REGISTER_CHARS_CONVERTER(classname, toStringFunc, fromStringFunc, toCharsFunc, fromCharsFunc) \
+	Converter::Impl::registerConverter<classname>(#classname, toStringFunc, fromStringFunc, toCharsFunc, fromCharsFunc);
+
 // Library to convert from any registered type to a string and vice versa
 // See the REGISTER_CONVERTER macro for how to register a type
 // Many defualt types are alreay registered
@@ -28,84 +80,544 @@ namespace Converter
 	using ToStringFunc = std::function<std::string(const T&)>;
 	template<typename T>
 	using FromStringFunc = std::function<T(const std::string&)>;
+	template<typename T>
+	using ToCharsFunc = std::function<void(const T&, OutputBuffer&)>;
+	template<typename T>
+	using FromCharsFunc = std::function<T(std::string_view)>;
+	template<typename T>
+	using TryFromCharsFunc = std::function<std::expected<T, ConvertError>(std::string_view)>;
+	template<typename T>
+	using EncodeFunc = std::function<void(const T&, ByteWriter&)>;
+	template<typename T>
+	using DecodeFunc = std::function<std::expected<T, ConvertError>(ByteReader&)>;
+
+	// Type erased forms of the functions above as stored in ConverterInfo
+	// They never allocate and reach the registered function through a single indirect call
+	using AnyToStringFunc = Impl::SmallFunction<std::string(const std::any&)>;
+	using AnyFromStringFunc = Impl::SmallFunction<std::any(const std::string&)>;
+	using AnyToCharsFunc = Impl::SmallFunction<void(const std::any&, OutputBuffer&)>;
+	using AnyToFormattedCharsFunc = Impl::SmallFunction<void(const std::any&, const FormatSpec&, OutputBuffer&)>;
+	using AnyFromCharsFunc = Impl::SmallFunction<std::any(std::string_view)>;
+	using AnyTryFromCharsFunc = Impl::SmallFunction<std::expected<std::any, ConvertError>(std::string_view)>;
+	using AnyEncodeFunc = Impl::SmallFunction<void(const std::any&, ByteWriter&)>;
+	using AnyDecodeFunc = Impl::SmallFunction<std::expected<std::any, ConvertError>(ByteReader&)>;
 
+	namespace Impl
+	{
+		struct ConverterCounters;
+	}
+
+	// A literal type so that converters can be built at compile time (see makeTraitsConverterInfo)
 	struct CONVERTER_EXPORT ConverterInfo
 	{
-		std::string name;
-		std::type_index index;
-		ToStringFunc<std::any> toStr;
-		FromStringFunc<std::any> fromStr;
+		// Registering a converter copies its name, so it only needs to outlive the registration call
+		std::string_view name;
+		const std::type_info* type;
+		AnyToStringFunc toStr;
+		AnyFromStringFunc fromStr;
+		// Optional; when empty the string functions are used instead
+		AnyToCharsFunc toChars;
+		AnyFromCharsFunc fromChars;
+		// Optional; when empty tryParse falls back to fromStr and maps its exceptions to errors
+		AnyTryFromCharsFunc tryFromChars;
+		// Optional; when empty a FormatSpec only pads the text of toChars / toStr to its width
+		AnyToFormattedCharsFunc toFormattedChars;
+		// Optional binary form; when empty the type can't be converted to bytes
+		AnyEncodeFunc encode;
+		AnyDecodeFunc decode;
+#ifdef CONVERTER_STATS
+		// Set when the converter is registered; the counters of the built-in converters are found by their position
+		Impl::ConverterCounters* counters = nullptr;
+#endif
+
+		std::type_index getIndex() const { return std::type_index(*type); }
+	};
+
+	struct ConverterInitOptions
+	{
+		// Log a line for every converter made available by initializeConverters or registered after it
+		bool logRegistrations = false;
+		// Threads (including the calling one) that parallelToStrings / parallelFromStrings split work across; 0 is one per core
+		std::size_t parallelThreads = 0;
 	};
 
 	// Implementation specifics
 	// No functions in this namespace should be called directly
 	namespace Impl
 	{
+		// Before initializeConverters this queues the converter; afterwards it is registered immediately
+		// and becomes visible to every thread at once
 		CONVERTER_EXPORT void addConverter(const ConverterInfo& info);
-		CONVERTER_EXPORT const std::vector<ConverterInfo>& getRegisteredConverters();
+		// The built-in converters followed by the registered ones
+		CONVERTER_EXPORT std::vector<const ConverterInfo*> getRegisteredConverters();
 
 		CONVERTER_EXPORT std::string getStrUsingConverter(const ConverterInfo& converter, const std::any& val);
 		CONVERTER_EXPORT std::any getAnyUsingConverter(const ConverterInfo& converter, const std::string& val);
+		CONVERTER_EXPORT void appendStrUsingConverter(const ConverterInfo& converter, const std::any& val, OutputBuffer& out);
+		CONVERTER_EXPORT void appendStrUsingConverter(const ConverterInfo& converter, const std::any& val, const FormatSpec& spec, OutputBuffer& out);
+		CONVERTER_EXPORT std::any getAnyUsingConverter(const ConverterInfo& converter, std::string_view val);
+		CONVERTER_EXPORT std::expected<std::any, ConvertError> tryGetAnyUsingConverter(const ConverterInfo& converter, std::string_view val);
+		CONVERTER_EXPORT bool encodeUsingConverter(const ConverterInfo& converter, const std::any& val, ByteWriter& out);
+		CONVERTER_EXPORT std::expected<std::any, ConvertError> decodeUsingConverter(const ConverterInfo& converter, ByteReader& in);
 
-		CONVERTER_EXPORT const ConverterInfo* findConverter(const std::string& name);
-		CONVERTER_EXPORT const ConverterInfo* findConverter(const std::type_index& index);
+		// O(1) lookups into the registry that never lock; safe to call while converters are being registered
+		// The built-in converters can be found at any time, even during static initialization before main;
+		// until initializeConverters indexes them they are searched in their compile time table.
+		// The returned converter stays valid for the lifetime of the program
+		// A miss returns nullptr and is only logged when logMissing is set
+		CONVERTER_EXPORT const ConverterInfo* findConverter(std::string_view name, bool logMissing = false);
+		CONVERTER_EXPORT const ConverterInfo* findConverter(const std::type_index& index, bool logMissing = false);
 
+		// Moves the T out of a converter's result without throwing
+		// A converter that returned another type is logged and reported as TypeMismatch
 		template<typename T>
-		void registerConverter(const std::string& name, ToStringFunc<T> toString, FromStringFunc<T> fromString)
+		std::expected<T, ConvertError> takeConverterResult(const ConverterInfo& converter, std::any& result)
 		{
-			Impl::addConverter(
-				ConverterInfo
+			T* value = std::any_cast<T>(&result);
+			if (!value)
+			{
+				Log::Error().log("Converter \"{}\" returned a value of the wrong type!", converter.name);
+				return std::unexpected(ConvertError::TypeMismatch);
+			}
+			return std::move(*value);
+		}
+
+		// The registration functions take any callable and store it inside the ConverterInfo thunks by value
+		// so a conversion is one indirect call into the thunk, which calls the callable directly
+		template<typename T, typename ToString, typename FromString>
+		ConverterInfo makeConverterInfo(std::string_view name, ToString toString, FromString fromString)
+		{
+			return ConverterInfo
+			{
+				.name    = name,
+				.type    = &typeid(T),
+				.toStr   = [toString](const std::any& val) -> std::string { return toString(std::any_cast<const T&>(val)); },
+				.fromStr = [fromString](const std::string& val) -> std::any { return std::any(T(fromString(val)));  },
+			};
+		}
+
+		template<typename T, typename ToChars, typename FromChars>
+		void addCharsFuncs(ConverterInfo& info, ToChars toChars, FromChars fromChars)
+		{
+			info.toChars   = [toChars](const std::any& val, OutputBuffer& out) { toChars(std::any_cast<const T&>(val), out); };
+			info.fromChars = [fromChars](std::string_view val) -> std::any { return std::any(T(fromChars(val))); };
+		}
+
+		template<typename T, typename TryFromChars>
+		void addTryFunc(ConverterInfo& info, TryFromChars tryFromChars)
+		{
+			info.tryFromChars = [tryFromChars](std::string_view val) -> std::expected<std::any, ConvertError>
+			{
+				std::expected<T, ConvertError> result = tryFromChars(val);
+				if (!result)
+					return std::unexpected(result.error());
+				return std::any(std::move(*result));
+			};
+		}
+
+		template<typename T, typename Encode, typename Decode>
+		void addBinaryFuncs(ConverterInfo& info, Encode encode, Decode decode)
+		{
+			info.encode = [encode](const std::any& val, ByteWriter& out) { encode(std::any_cast<const T&>(val), out); };
+			info.decode = [decode](ByteReader& in) -> std::expected<std::any, ConvertError>
+			{
+				std::expected<T, ConvertError> result = decode(in);
+				if (!result)
+					return std::unexpected(result.error());
+				return std::any(std::move(*result));
+			};
+		}
+
+		template<typename T, typename ToString, typename FromString>
+		void registerConverter(std::string_view name, ToString toString, FromString fromString)
+		{
+			Impl::addConverter(makeConverterInfo<T>(name, toString, fromString));
+		}
+
+		template<typename T, typename ToString, typename FromString, typename ToChars, typename FromChars>
+		void registerConverter(std::string_view name, ToString toString, FromString fromString, ToChars toChars, FromChars fromChars)
+		{
+			ConverterInfo info = makeConverterInfo<T>(name, toString, fromString);
+			addCharsFuncs<T>(info, toChars, fromChars);
+			Impl::addConverter(info);
+		}
+
+		template<typename T, typename ToString, typename FromString, typename Encode, typename Decode>
+		void registerBinaryConverter(std::string_view name, ToString toString, FromString fromString, Encode encode, Decode decode)
+		{
+			ConverterInfo info = makeConverterInfo<T>(name, toString, fromString);
+			addBinaryFuncs<T>(info, encode, decode);
+			Impl::addConverter(info);
+		}
+
+		// Builds every form of the converter from an appending formatter and a non-throwing parser
+		template<typename T, typename ToChars, typename TryFromChars>
+		void registerTryConverter(std::string_view name, ToChars toChars, TryFromChars tryFromChars)
+		{
+			auto toString = [toChars](const T& val) { OutputBuffer out; toChars(val, out); return out.str(); };
+			auto fromChars = [tryFromChars](std::string_view str) -> T
+			{
+				std::expected<T, ConvertError> result = tryFromChars(str);
+				if (result)
+					return std::move(*result);
+
+				// The name is looked up in the registry on failure rather than captured, which would make
+				// this callable too large for the SmallFunction thunks it is stored in
+				const ConverterInfo* converter = findConverter(std::type_index(typeid(T)));
+				return valueOrLogError<T>(std::move(result), str, converter ? converter->name : std::string_view(typeid(T).name()));
+			};
+			ConverterInfo info = makeConverterInfo<T>(name, toString, [fromChars](const std::string& str) { return fromChars(str); });
+			addCharsFuncs<T>(info, toChars, fromChars);
+			addTryFunc<T>(info, tryFromChars);
+			Impl::addConverter(info);
+		}
+
+		// Builds the converter for a type with Converter::Traits at compile time
+		// Every function is a captureless thunk that calls the traits, so there is no stored state at all
+		template<typename T>
+			requires HasTraits<T>
+		constexpr ConverterInfo makeTraitsConverterInfo(std::string_view name)
+		{
+			ConverterInfo info
+			{
+				.name    = name,
+				.type    = &typeid(T),
+				.toStr   = [](const std::any& val) -> std::string { return Traits<T>::toString(std::any_cast<const T&>(val)); },
+				.fromStr = [](const std::string& val) -> std::any { return std::any(Traits<T>::fromString(val)); },
+			};
+			if constexpr (HasCharsTraits<T>)
+			{
+				info.toChars   = [](const std::any& val, OutputBuffer& out) { Traits<T>::toChars(std::any_cast<const T&>(val), out); };
+				info.fromChars = [](std::string_view val) -> std::any { return std::any(Traits<T>::fromChars(val)); };
+			}
+			if constexpr (HasSpecTraits<T>)
+			{
+				info.toFormattedChars = [](const std::any& val, const FormatSpec& spec, OutputBuffer& out) { Traits<T>::toFormattedChars(std::any_cast<const T&>(val), spec, out); };
+			}
+			if constexpr (HasTryTraits<T>)
+			{
+				info.tryFromChars = [](std::string_view val) -> std::expected<std::any, ConvertError>
 				{
-					.name    = name,
-					.index   = std::type_index(typeid(T)),
-					.toStr   = [toString](const std::any& val) -> std::string { return toString(std::any_cast<T>(val)); },
-					.fromStr = [fromString](const std::string& val) -> std::any { return std::any(fromString(val));  },
-				}
-			);
+					auto result = Traits<T>::tryFromChars(val);
+					if (!result)
+						return std::unexpected(result.error());
+					return std::any(std::move(*result));
+				};
+			}
+			if constexpr (HasBinaryTraits<T>)
+			{
+				info.encode = [](const std::any& val, ByteWriter& out) { Traits<T>::encode(std::any_cast<const T&>(val), out); };
+				info.decode = [](ByteReader& in) -> std::expected<std::any, ConvertError>
+				{
+					auto result = Traits<T>::decode(in);
+					if (!result)
+						return std::unexpected(result.error());
+					return std::any(std::move(*result));
+				};
+			}
+			return info;
+		}
+
+		template<typename T>
+			requires HasTraits<T>
+		void registerTraitsConverter(std::string_view name)
+		{
+			Impl::addConverter(makeTraitsConverterInfo<T>(name));
+		}
+
+		template<typename T>
+		void registerEnumConverter(std::string_view name)
+		{
+			static_assert(std::is_enum_v<T>, "REGISTER_ENUM_CONVERTER requires an enum type");
+			static_assert(ReflectedEnum<T>, "REGISTER_ENUM_CONVERTER requires ENABLE_ENUM_CONVERTER (or a Converter::EnumRange specialization) for the enum");
+			registerTraitsConverter<T>(name);
 		}
 	}
 
 	// Call this funciton once at program initialization
 	// This library uses the logging library and depends on logging
 	// being initialized before the call to initializeConverters
-	CONVERTER_EXPORT void initializeConverters();
+	// The built-in converters are compiled into a constant table and need no registration; this
+	// registers the converters queued by REGISTER_ macros that ran before it and indexes the built-ins.
+	// Converters registered later (e.g. by a dynamically loaded module) are available as soon as
+	// their REGISTER_ macro returns, on every thread
+	CONVERTER_EXPORT void initializeConverters(const ConverterInitOptions& opts = ConverterInitOptions());
 
 	// Use the registered converter to turn the type T into a string
+	// Types with Converter::Traits are converted directly without going through the registry
 	template<typename T>
 	std::string getStringForType(const T& val)
 	{
-		if (auto* converter = Impl::findConverter(std::type_index(typeid(T))))
-			return Impl::getStrUsingConverter(*converter, std::any(val));
+		if constexpr (HasTraits<T>)
+		{
+			return Traits<T>::toString(val);
+		}
+		else
+		{
+			if (auto* converter = Impl::findConverter(std::type_index(typeid(T)), true))
+				return Impl::getStrUsingConverter(*converter, std::any(val));
+
+			return "";
+		}
+	}
+
+	// Use the registered converter to append the type T to a caller owned buffer
+	// Doesn't allocate for types whose traits or registered converter provide toChars
+	template<typename T>
+	void getStringForType(const T& val, OutputBuffer& out)
+	{
+		if constexpr (HasCharsTraits<T>)
+		{
+			Traits<T>::toChars(val, out);
+		}
+		else if constexpr (HasTraits<T>)
+		{
+			out.append(Traits<T>::toString(val));
+		}
+		else
+		{
+			if (auto* converter = Impl::findConverter(std::type_index(typeid(T)), true))
+				Impl::appendStrUsingConverter(*converter, std::any(val), out);
+		}
+	}
+
+	// Use the registered converter to append the type T to a caller owned buffer, formatted as spec describes
+	// Parse the spec once with parseFormatSpec and reuse it for every value; see FormatSpec.h for what it supports
+	// The default spec writes exactly what getStringForType(val, out) writes
+	template<typename T>
+	void getStringForType(const T& val, const FormatSpec& spec, OutputBuffer& out)
+	{
+		if (spec.isDefault())
+		{
+			getStringForType(val, out);
+		}
+		else if constexpr (HasSpecTraits<T>)
+		{
+			Traits<T>::toFormattedChars(val, spec, out);
+		}
+		else if constexpr (HasTraits<T>)
+		{
+			const std::size_t start = out.size();
+			getStringForType(val, out);
+			Impl::alignFormatted(spec, out, start);
+		}
+		else
+		{
+			if (auto* converter = Impl::findConverter(std::type_index(typeid(T)), true))
+				Impl::appendStrUsingConverter(*converter, std::any(val), spec, out);
+		}
+	}
 
-		return "";
+	// Use the registered converter to turn the type T into a string formatted as spec describes
+	template<typename T>
+	std::string getStringForType(const T& val, const FormatSpec& spec)
+	{
+		OutputBuffer out;
+		getStringForType(val, spec, out);
+		return out.str();
 	}
 
 	// Use the registered converter to turn a string into type T
+	// Types with Converter::Traits are converted directly without going through the registry
+	template<typename T>
+	T getTypeFromString(std::string_view str)
+	{
+		if constexpr (HasCharsTraits<T>)
+		{
+			return Traits<T>::fromChars(str);
+		}
+		else if constexpr (HasTraits<T>)
+		{
+			return Traits<T>::fromString(std::string(str));
+		}
+		else
+		{
+			if (auto* converter = Impl::findConverter(std::type_index(typeid(T)), true))
+			{
+				try
+				{
+					return std::any_cast<T>(Impl::getAnyUsingConverter(*converter, str));
+				}
+				catch (const std::bad_any_cast& e)
+				{
+					Log::Error().log(
+						"Unable to convert string to type; could not cast converter result to type: {}! "
+						"Attempted to use converter with name: {}",
+						std::type_index(typeid(T)), converter->name
+					);
+					assert(false && "Caught bad any cast!");
+				}
+			}
+
+			return T();
+		}
+	}
+
+	// Parse str into a T without throwing
+	// Errors: InvalidSyntax, OutOfRange, TrailingCharacters, or NoConverter if T has neither traits nor a registered converter
+	// (TypeMismatch if the registered converter returns another type)
+	// Traits and converters without a non-throwing parse function are called through their throwing
+	// forms; std::out_of_range is mapped to OutOfRange and any other std::exception to InvalidSyntax
 	template<typename T>
-	T getTypeFromString(const std::string& str)
+	std::expected<T, ConvertError> tryParse(std::string_view str)
 	{
-		if (auto* converter = Impl::findConverter(std::type_index(typeid(T))))
+		if constexpr (HasTryTraits<T>)
+		{
+			return Traits<T>::tryFromChars(str);
+		}
+		else if constexpr (HasTraits<T>)
 		{
 			try
 			{
-				return std::any_cast<T>(Impl::getAnyUsingConverter(*converter, str));
+				if constexpr (HasCharsTraits<T>)
+					return Traits<T>::fromChars(str);
+				else
+					return Traits<T>::fromString(std::string(str));
+			}
+			catch (const std::out_of_range&)
+			{
+				return std::unexpected(ConvertError::OutOfRange);
 			}
-			catch (const std::bad_any_cast& e)
+			catch (const std::exception&)
 			{
-				Log::Error().log(
-					"Unable to convert string to type; could not cast converter result to type: {}! "
-					"Attempted to use converter with name: {}",
-					std::type_index(typeid(T)), converter->name
-				);
-				assert(false && "Caught bad any cast!");
+				return std::unexpected(ConvertError::InvalidSyntax);
 			}
 		}
+		else
+		{
+			auto* converter = Impl::findConverter(std::type_index(typeid(T)));
+			if (!converter)
+				return std::unexpected(ConvertError::NoConverter);
+
+			auto result = Impl::tryGetAnyUsingConverter(*converter, str);
+			if (!result)
+				return std::unexpected(result.error());
 
-		return T();
+			return Impl::takeConverterResult<T>(*converter, *result);
+		}
+	}
+
+	// Use the binary form of the converter to append val to out
+	// Returns false if T has neither binary traits nor a registered converter with a binary form
+	template<typename T>
+	bool getBytesForType(const T& val, ByteWriter& out)
+	{
+		if constexpr (HasBinaryTraits<T>)
+		{
+			Traits<T>::encode(val, out);
+			return true;
+		}
+		else
+		{
+			auto* converter = Impl::findConverter(std::type_index(typeid(T)), true);
+			return converter && Impl::encodeUsingConverter(*converter, std::any(val), out);
+		}
+	}
+
+	// Decode a T from the front of in, leaving the rest of the bytes in the reader
+	template<typename T>
+	std::expected<T, ConvertError> getTypeFromBytes(ByteReader& in)
+	{
+		if constexpr (HasBinaryTraits<T>)
+		{
+			return Traits<T>::decode(in);
+		}
+		else
+		{
+			auto* converter = Impl::findConverter(std::type_index(typeid(T)));
+			if (!converter)
+				return std::unexpected(ConvertError::NoConverter);
+
+			auto result = Impl::decodeUsingConverter(*converter, in);
+			if (!result)
+				return std::unexpected(result.error());
+
+			return Impl::takeConverterResult<T>(*converter, *result);
+		}
 	}
 
 	// Use a type index to convert val into a string using a registered converter
 	CONVERTER_EXPORT std::string getStringFromAny(const std::type_index& index, const std::any val);
 	// Use a name lookup to convert val into a string using a registered converter
 	CONVERTER_EXPORT std::string getStringFromAny(const std::string& name, const std::any val);
+	// Use a type index to append val to a caller owned buffer using a registered converter
+	// Returns false if no converter was found
+	CONVERTER_EXPORT bool getStringFromAny(const std::type_index& index, const std::any& val, OutputBuffer& out);
+	// Use a name lookup to append val to a caller owned buffer using a registered converter
+	// Returns false if no converter was found
+	CONVERTER_EXPORT bool getStringFromAny(std::string_view name, const std::any& val, OutputBuffer& out);
+	// Versions of getStringFromAny that format val as spec describes, see FormatSpec.h
+	CONVERTER_EXPORT std::string getStringFromAny(const std::type_index& index, const std::any& val, const FormatSpec& spec);
+	CONVERTER_EXPORT std::string getStringFromAny(std::string_view name, const std::any& val, const FormatSpec& spec);
+	CONVERTER_EXPORT bool getStringFromAny(const std::type_index& index, const std::any& val, const FormatSpec& spec, OutputBuffer& out);
+	CONVERTER_EXPORT bool getStringFromAny(std::string_view name, const std::any& val, const FormatSpec& spec, OutputBuffer& out);
+	// Use a type index to parse str using a registered converter
+	// Returns an empty any if no converter was found
+	CONVERTER_EXPORT std::any getAnyFromString(const std::type_index& index, std::string_view str);
+	// Use a name lookup to parse str using a registered converter
+	// Returns an empty any if no converter was found
+	CONVERTER_EXPORT std::any getAnyFromString(std::string_view name, std::string_view str);
+	// Non-throwing versions of getAnyFromString, see tryParse
+	CONVERTER_EXPORT std::expected<std::any, ConvertError> tryGetAnyFromString(const std::type_index& index, std::string_view str);
+	CONVERTER_EXPORT std::expected<std::any, ConvertError> tryGetAnyFromString(std::string_view name, std::string_view str);
+	// Use a type index to encode val using the binary form of a registered converter
+	// Returns no bytes if no converter with a binary form was found
+	CONVERTER_EXPORT std::vector<std::byte> getBytesFromAny(const std::type_index& index, const std::any& val);
+	// Use a name lookup to encode val using the binary form of a registered converter
+	// Returns no bytes if no converter with a binary form was found
+	CONVERTER_EXPORT std::vector<std::byte> getBytesFromAny(std::string_view name, const std::any& val);
+	// Use a type index to append the encoding of val to a caller owned buffer
+	// Returns false if no converter with a binary form was found
+	CONVERTER_EXPORT bool getBytesFromAny(const std::type_index& index, const std::any& val, ByteWriter& out);
+	// Use a name lookup to append the encoding of val to a caller owned buffer
+	// Returns false if no converter with a binary form was found
+	CONVERTER_EXPORT bool getBytesFromAny(std::string_view name, const std::any& val, ByteWriter& out);
+	// Use a type index to decode a value from the front of in using a registered converter
+	// Returns an empty any if no converter with a binary form was found or the bytes are invalid
+	CONVERTER_EXPORT std::any getAnyFromBytes(const std::type_index& index, ByteReader& in);
+	// Use a name lookup to decode a value from the front of in using a registered converter
+	// Returns an empty any if no converter with a binary form was found or the bytes are invalid
+	CONVERTER_EXPORT std::any getAnyFromBytes(std::string_view name, ByteReader& in);
+
+	// Wraps a value so that std::format (and so the logger) prints it with its converter (traits or registered)
+	// The format spec is parsed once by std::format and applied as getStringForType does
+	// Example usage:
+	//    Log::Info().log("Value: {} / {:>12}", Converter::formatted(myValue), Converter::formatted(myVector));
+	template<typename T>
+	struct Formatted
+	{
+		const T& value;
+	};
+
+	template<typename T>
+	Formatted<T> formatted(const T& val)
+	{
+		return Formatted<T>{ val };
+	}
 }
+
+// Formats a Converter::Formatted value using the converter registered for T
+// Format specs are parsed with Converter::parseFormatSpec; nested replacement fields are not supported
+template<typename T>
+struct std::formatter<Converter::Formatted<T>, char>
+{
+	constexpr auto parse(std::format_parse_context& ctx)
+	{
+		auto end = std::find(ctx.begin(), ctx.end(), '}');
+		auto spec = Converter::parseFormatSpec(std::string_view(ctx.begin(), end));
+		if (!spec)
+			throw std::format_error("Invalid format spec for Converter::Formatted");
+		m_spec = *spec;
+		return end;
+	}
+
+	auto format(const Converter::Formatted<T>& val, std::format_context& ctx) const
+	{
+		Converter::Impl::ScratchBuffer scratch;
+		Converter::getStringForType(val.value, m_spec, scratch.get());
+		return std::ranges::copy(scratch.get().view(), ctx.out()).out;
+	}
+
+private:
+	Converter::FormatSpec m_spec;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Converter/ConverterExport.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Usage counters of the registered converters
+// Configure with -DCONVERTER_STATS=ON to count every conversion that goes through a ConverterInfo: the
+// getStringFromAny family, and the templated functions for types without traits. Types with traits are
+// converted directly by the templates and never reach their ConverterInfo, so they are only counted when
+// converted through the type erased functions.
+//
+// Counters are sharded by thread so that threads converting with the same converter don't contend, and
+// one in c_latencySampleRate calls per thread is timed. Without CONVERTER_STATS none of this is compiled
+// in; getConverterStats returns nothing and dumpStats only says so.
+//
+// Example usage:
+//    Converter::dumpStats();   // Logs one line per converter that has been used, busiest first
+namespace Converter
+{
+#ifdef CONVERTER_STATS
+	inline constexpr bool c_statsEnabled = true;
+#else
+	inline constexpr bool c_statsEnabled = false;
+#endif
+
+	// Bucket i of a latency histogram counts calls that took less than 2^(i + 1) ns (and at least 2^i ns)
+	// The last bucket also counts everything slower
+	inline constexpr std::size_t c_latencyBuckets = 24;
+	// Every thread times one in this many of its calls
+	inline constexpr std::uint32_t c_latencySampleRate = 64;
+
+	struct ConverterStats
+	{
+		std::string_view name;
+		std::uint64_t toStringCalls = 0;   // To text, with or without a FormatSpec
+		std::uint64_t fromStringCalls = 0; // From text, throwing or not
+		std::uint64_t encodeCalls = 0;
+		std::uint64_t decodeCalls = 0;
+		std::uint64_t bytesProduced = 0;   // Characters written by to string calls and bytes written by encodes
+		std::uint64_t bytesConsumed = 0;   // Characters parsed and bytes decoded
+		std::uint64_t failures = 0;        // Parse and decode errors, and the bad casts that are also logged
+		std::array<std::uint64_t, c_latencyBuckets> latency{};
+
+		std::uint64_t getCalls() const { return toStringCalls + fromStringCalls + encodeCalls + decodeCalls; }
+		CONVERTER_EXPORT std::uint64_t getLatencySamples() const;
+
+		// Upper bound in ns of the given fraction (0 - 1) of the sampled calls, or 0 if none were sampled
+		CONVERTER_EXPORT std::uint64_t getLatencyPercentile(double fraction) const;
+	};
+
+	// Totals of every converter that has been called, busiest first
+	CONVERTER_EXPORT std::vector<ConverterStats> getConverterStats();
+	// Sets every counter back to zero; calls running at the same time may be counted either way
+	CONVERTER_EXPORT void resetConverterStats();
+	// Logs getConverterStats, one line per converter
+	CONVERTER_EXPORT void dumpStats();
+}
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <Converter/ConvertError.h>
+#include <Converter/OutputBuffer.h>
+#include <Converter/Traits.h>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <expected>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Compile time enum converters
+// Enums that opt in with ENABLE_ENUM_CONVERTER (or a specialization of EnumRange) get Converter::Traits
+// that convert values to and from their enumerator names.
+// The names are read from the compiler's pretty function name for each value in EnumRange<E>, so
+// both tables are built at compile time:
+//    value -> name: an array indexed by (value - min)
+//    name -> value: an array sorted by name, searched with a binary search
+//
+// Values without a name (outside the range, or combinations of flags) are written as their
+// underlying number, and numbers are accepted when parsing.
+// When several enumerators share a value only the name the compiler reports for it is known.
+//
+// Use REGISTER_ENUM_CONVERTER to also make an enum available to the type erased functions.
+
+// Give an enum compile time traits over the default range (see Converter::DefaultEnumRange)
+// Use this at global namespace scope, after the enum is declared:
+//		ENABLE_ENUM_CONVERTER(MyNamespace::MyEnum)
+#define ENABLE_ENUM_CONVERTER(...) \
+	template<> \
+	struct Converter::EnumRange<__VA_ARGS__> : Converter::DefaultEnumRange<__VA_ARGS__> {};
+
+namespace Converter
+{
+	namespace Impl
+	{
+		// Only enums with a fixed underlying type can hold every value of it; those are the ones that
+		// can be list initialized from it
+		template<typename E>
+		concept FixedUnderlyingEnum = std::is_enum_v<E> && requires { E{ std::underlying_type_t<E>{} }; };
+	}
+
+	// Underlying values that are searched for enumerator names, clamped to the underlying type
+	// Not defined for enums that haven't opted in, so they get no traits
+	// Specialize this for enums with values outside the default range:
+	//
+	//		template<>
+	//		struct Converter::EnumRange<MyEnum>
+	//		{
+	//			static constexpr long long c_min = 0;
+	//			static constexpr long long c_max = 1000;
+	//		};
+	//
+	// Unscoped enums without a fixed underlying type must not have a range beyond their values.
+	template<typename E>
+	struct EnumRange;
+
+	// [-128, 127], or [0, 255] for unsigned underlying types
+	template<typename E>
+	struct DefaultEnumRange
+	{
+		static_assert(Impl::FixedUnderlyingEnum<E>, "The default range needs an enum with a fixed underlying type; specialize Converter::EnumRange with the enum's own range instead");
+
+		static constexpr bool c_signed = std::is_signed_v<std::underlying_type_t<E>>;
+		static constexpr long long c_min = c_signed ? -128 : 0;
+		static constexpr long long c_max = c_signed ? 127 : 255;
+	};
+
+	namespace Impl
+	{
+		// Enums that have opted in to compile time traits
+		template<typename E>
+		concept ReflectedEnum = std::is_enum_v<E> && requires
+		{
+			{ EnumRange<E>::c_min } -> std::convertible_to<long long>;
+			{ EnumRange<E>::c_max } -> std::convertible_to<long long>;
+		};
+
+		template<auto V>
+		constexpr auto getPrettyName()
+		{
+#if defined(_MSC_VER)
+			return std::string_view(__FUNCSIG__);
+#else
+			return std::string_view(__PRETTY_FUNCTION__);
+#endif
+		}
+
+		constexpr bool isIdentifier(std::string_view str)
+		{
+			if (str.empty() || (str.front() >= '0' && str.front() <= '9'))
+				return false;
+
+			return std::all_of(str.begin(), str.end(), [](char c)
+				{
+					return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+				});
+		}
+
+		// Returns the enumerator name of V, or an empty string if V is not an enumerator
+		// The pretty name ends with "...V = Scope::name]" (GCC / Clang) or "...<Scope::name>(void)" (MSVC);
+		// values without a name are printed as a cast such as "(Scope)5" and are rejected.
+		template<auto V>
+		constexpr std::string_view getEnumValueName()
+		{
+			constexpr std::string_view prettyName = getPrettyName<V>();
+#if defined(_MSC_VER)
+			constexpr std::string_view suffix = ">(void)";
+#else
+			constexpr std::string_view suffix = "]";
+#endif
+			constexpr std::string_view value = prettyName.substr(0, prettyName.size() - suffix.size());
+			constexpr std::string_view name = value.substr(value.find_last_of(" :<") + 1);
+
+			if constexpr (isIdentifier(name))
+				return name;
+			else
+				return std::string_view();
+		}
+
+		template<typename E>
+		struct EnumTable
+		{
+			using Underlying = std::underlying_type_t<E>;
+
+			static constexpr long long c_min = std::max<long long>(EnumRange<E>::c_min, std::numeric_limits<Underlying>::min());
+			static constexpr long long c_max = std::min<long long>(EnumRange<E>::c_max, static_cast<long long>(std::numeric_limits<Underlying>::max()));
+			static constexpr std::size_t c_rangeSize = static_cast<std::size_t>(c_max - c_min + 1);
+
+			template<std::size_t... Is>
+			static constexpr std::array<std::string_view, c_rangeSize> makeNames(std::index_sequence<Is...>)
+			{
+				return { getEnumValueName<static_cast<E>(static_cast<Underlying>(c_min + static_cast<long long>(Is)))>()... };
+			}
+
+			// Indexed by value - c_min; empty for values that are not enumerators
+			static constexpr std::array<std::string_view, c_rangeSize> c_names = makeNames(std::make_index_sequence<c_rangeSize>());
+
+			static constexpr std::size_t c_count = static_cast<std::size_t>(std::count_if(c_names.begin(), c_names.end(), [](std::string_view name) { return !name.empty(); }));
+
+			struct Entry
+			{
+				std::string_view name;
+				E value;
+			};
+
+			static constexpr std::array<Entry, c_count> makeSorted()
+			{
+				std::array<Entry, c_count> sorted{};
+				std::size_t count = 0;
+				for (std::size_t i = 0; i < c_rangeSize; i++)
+				{
+					if (!c_names[i].empty())
+						sorted[count++] = Entry{ c_names[i], static_cast<E>(static_cast<Underlying>(c_min + static_cast<long long>(i))) };
+				}
+				std::sort(sorted.begin(), sorted.end(), [](const Entry& a, const Entry& b) { return a.name < b.name; });
+				return sorted;
+			}
+
+			// Sorted by name for parsing
+			static constexpr std::array<Entry, c_count> c_sorted = makeSorted();
+
+			static constexpr std::string_view getName(E value)
+			{
+				const long long index = static_cast<long long>(static_cast<Underlying>(value)) - c_min;
+				if (index < 0 || index >= static_cast<long long>(c_rangeSize))
+					return std::string_view();
+				return c_names[static_cast<std::size_t>(index)];
+			}
+
+			static constexpr const Entry* findName(std::string_view name)
+			{
+				auto it = std::lower_bound(c_sorted.begin(), c_sorted.end(), name, [](const Entry& entry, std::string_view key) { return entry.name < key; });
+				if (it == c_sorted.end() || it->name != name)
+					return nullptr;
+				return &*it;
+			}
+		};
+	}
+
+	template<typename E>
+		requires Impl::ReflectedEnum<E>
+	struct Traits<E>
+	{
+		using Table = Impl::EnumTable<E>;
+		using Underlying = std::underlying_type_t<E>;
+
+		static std::string toString(const E& val)
+		{
+			OutputBuffer out;
+			toChars(val, out);
+			return out.str();
+		}
+
+		static E fromString(const std::string& str)
+		{
+			return fromChars(str);
+		}
+
+		static void toChars(const E& val, OutputBuffer& out)
+		{
+			const std::string_view name = Table::getName(val);
+			if (!name.empty())
+				out.append(name);
+			else
+				Impl::NumberTraits<Underlying>::toChars(static_cast<Underlying>(val), out);
+		}
+
+		static E fromChars(std::string_view str)
+		{
+			return Impl::valueOrLogError(tryFromChars(str), str, "an enum");
+		}
+
+		static std::expected<E, ConvertError> tryFromChars(std::string_view str)
+		{
+			if (const auto* entry = Table::findName(str))
+				return entry->value;
+
+			auto number = Impl::NumberTraits<Underlying>::tryFromChars(str);
+			if (!number)
+				return std::unexpected(number.error());
+			return static_cast<E>(*number);
+		}
+
+		// Binary: the underlying value
+		static void encode(const E& val, ByteWriter& out)
+		{
+			Impl::NumberTraits<Underlying>::encode(static_cast<Underlying>(val), out);
+		}
+
+		static std::expected<E, ConvertError> decode(ByteReader& in)
+		{
+			auto number = Impl::NumberTraits<Underlying>::decode(in);
+			if (!number)
+				return std::unexpected(number.error());
+			return static_cast<E>(*number);
+		}
+	};
+}
+
+// The Logger's enums; Logger can't depend on Converter so they opt in here
+ENABLE_ENUM_CONVERTER(Log::Color)
+ENABLE_ENUM_CONVERTER(Log::Level)
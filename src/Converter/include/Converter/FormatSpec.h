@@ -0,0 +1,189 @@
+#pragma once
+
+#include <Converter/ConvertError.h>
+#include <Converter/ConverterExport.h>
+#include <Converter/OutputBuffer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string_view>
+
+// Pre-parsed std::format style format specs
+// Parse a spec once and pass it to getStringForType / getStringFromAny for every value it applies to:
+//
+//    constexpr auto spec = Converter::parseFormatSpec(">10.3f");   // The part after ':' in "{:>10.3f}"
+//    Converter::OutputBuffer out;
+//    for (double val : values)
+//        Converter::getStringForType(val, *spec, out);
+//
+// The grammar is std::format's: [[fill]align][sign][#][0][width][.precision][type]
+// Nested replacement fields ("{:{}}") and 'L' are not supported; converters never use the locale.
+// Widths count characters (bytes), not display columns.
+//
+// What a spec means depends on the type it is applied to:
+// Integers:         sign, '#', '0', width and the types b B d o x X
+// Floating point:   sign, '#', '0', width, precision and the types a A e E f F g G; with no type the
+//                   value is written in its shortest form, or as 'g' with the given precision
+// bool:             's' writes true / false, the integer types write 1 / 0
+// char:             'c' writes the character, the integer types its code
+// std::string:      precision truncates, type 's'
+// Every other type: fill, align and width are applied to the text of its converter
+// Formatting with a spec a type doesn't support is a programming error; it is logged and asserted
+// and the value is written without the unsupported parts.
+namespace Converter
+{
+	struct FormatSpec
+	{
+		enum class Align : std::uint8_t
+		{
+			Default, // Right for numbers, left for everything else
+			Left,
+			Right,
+			Center,
+		};
+
+		enum class Sign : std::uint8_t
+		{
+			Default, // Only negative numbers get a sign
+			Plus,
+			Space,
+		};
+
+		char fill = ' ';
+		Align align = Align::Default;
+		Sign sign = Sign::Default;
+		bool alternate = false;
+		bool zeroPad = false;
+		std::uint32_t width = 0;
+		std::int32_t precision = -1; // -1 if the spec has none
+		char type = '\0';            // '\0' if the spec has none
+
+		bool operator==(const FormatSpec&) const = default;
+
+		// True for the empty spec ("{}"), which writes exactly what the spec-less functions write
+		constexpr bool isDefault() const { return *this == FormatSpec{}; }
+	};
+
+	// Largest width or precision a spec may have
+	inline constexpr std::uint32_t c_maxFormatWidth = 1 << 20;
+
+	namespace Impl
+	{
+		constexpr FormatSpec::Align getFormatAlign(char c)
+		{
+			switch (c)
+			{
+			case '<':
+				return FormatSpec::Align::Left;
+			case '>':
+				return FormatSpec::Align::Right;
+			case '^':
+				return FormatSpec::Align::Center;
+			default:
+				return FormatSpec::Align::Default;
+			}
+		}
+
+		constexpr std::expected<std::uint32_t, ConvertError> readFormatNumber(std::string_view str, std::size_t& pos)
+		{
+			std::uint32_t val = 0;
+			const std::size_t start = pos;
+			for (; pos < str.size() && str[pos] >= '0' && str[pos] <= '9'; pos++)
+			{
+				val = val * 10 + static_cast<std::uint32_t>(str[pos] - '0');
+				if (val > c_maxFormatWidth)
+					return std::unexpected(ConvertError::OutOfRange);
+			}
+			if (pos == start)
+				return std::unexpected(ConvertError::InvalidSyntax);
+			return val;
+		}
+	}
+
+	// Parses the spec part of a std::format replacement field, i.e. what follows the ':'
+	// Usable at compile time
+	// Errors: InvalidSyntax, OutOfRange for a width or precision above c_maxFormatWidth,
+	// TrailingCharacters if anything follows the type
+	constexpr std::expected<FormatSpec, ConvertError> parseFormatSpec(std::string_view str)
+	{
+		using Align = FormatSpec::Align;
+
+		FormatSpec spec;
+		std::size_t pos = 0;
+		if (str.size() >= 2 && Impl::getFormatAlign(str[1]) != Align::Default)
+		{
+			if (str[0] == '{' || str[0] == '}')
+				return std::unexpected(ConvertError::InvalidSyntax);
+			spec.fill = str[0];
+			spec.align = Impl::getFormatAlign(str[1]);
+			pos = 2;
+		}
+		else if (!str.empty() && Impl::getFormatAlign(str[0]) != Align::Default)
+		{
+			spec.align = Impl::getFormatAlign(str[0]);
+			pos = 1;
+		}
+
+		if (pos < str.size() && (str[pos] == '+' || str[pos] == '-' || str[pos] == ' '))
+		{
+			spec.sign = str[pos] == '+' ? FormatSpec::Sign::Plus : str[pos] == ' ' ? FormatSpec::Sign::Space : FormatSpec::Sign::Default;
+			pos++;
+		}
+		if (pos < str.size() && str[pos] == '#')
+		{
+			spec.alternate = true;
+			pos++;
+		}
+		if (pos < str.size() && str[pos] == '0')
+		{
+			spec.zeroPad = true;
+			pos++;
+		}
+		if (pos < str.size() && str[pos] >= '1' && str[pos] <= '9')
+		{
+			auto width = Impl::readFormatNumber(str, pos);
+			if (!width)
+				return std::unexpected(width.error());
+			spec.width = *width;
+		}
+		if (pos < str.size() && str[pos] == '.')
+		{
+			pos++;
+			auto precision = Impl::readFormatNumber(str, pos);
+			if (!precision)
+				return std::unexpected(precision.error());
+			spec.precision = static_cast<std::int32_t>(*precision);
+		}
+
+		if (pos < str.size())
+		{
+			constexpr std::string_view c_types = "aAbBcdeEfFgGosxX";
+			if (c_types.find(str[pos]) == std::string_view::npos)
+				return std::unexpected(ConvertError::InvalidSyntax);
+			spec.type = str[pos++];
+		}
+		if (pos < str.size())
+			return std::unexpected(ConvertError::TrailingCharacters);
+
+		return spec;
+	}
+
+	namespace Impl
+	{
+		// Spec aware formatters of the built-in traits, see Traits.h
+		// Each appends val to out as the spec describes
+		CONVERTER_EXPORT void formatInteger(std::int64_t val, const FormatSpec& spec, OutputBuffer& out);
+		CONVERTER_EXPORT void formatInteger(std::uint64_t val, const FormatSpec& spec, OutputBuffer& out);
+		CONVERTER_EXPORT void formatFloat(float val, const FormatSpec& spec, OutputBuffer& out);
+		CONVERTER_EXPORT void formatFloat(double val, const FormatSpec& spec, OutputBuffer& out);
+		CONVERTER_EXPORT void formatFloat(long double val, const FormatSpec& spec, OutputBuffer& out);
+		CONVERTER_EXPORT void formatString(std::string_view val, const FormatSpec& spec, OutputBuffer& out);
+		CONVERTER_EXPORT void formatBool(bool val, const FormatSpec& spec, OutputBuffer& out);
+		CONVERTER_EXPORT void formatChar(char val, const FormatSpec& spec, OutputBuffer& out);
+
+		// Pads the text from start to the end of out to the width of spec
+		// Used for types without spec aware formatting, so spec may only have fill, align and width
+		CONVERTER_EXPORT void alignFormatted(const FormatSpec& spec, OutputBuffer& out, std::size_t start);
+	}
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace Converter
+{
+	// Caller owned character buffer that converters append into
+	// Reusing one buffer across many conversions means no allocation per converted value once
+	// the buffer has grown to its working size. clear() keeps the capacity.
+	//
+	// Converters can either append finished text:
+	//    out.append("text");
+	// or write in place:
+	//    char* dst = out.prepare(maxSize);
+	//    out.commit(writtenSize);
+	class OutputBuffer
+	{
+	public:
+		OutputBuffer() = default;
+		explicit OutputBuffer(std::size_t capacity) { reserve(capacity); }
+
+		void append(std::string_view str)
+		{
+			char* dst = prepare(str.size());
+			std::copy(str.begin(), str.end(), dst);
+			commit(str.size());
+		}
+
+		void push_back(char c)
+		{
+			*prepare(1) = c;
+			commit(1);
+		}
+
+		// Returns space for at least n more characters; only commit() makes them part of the buffer
+		char* prepare(std::size_t n)
+		{
+			if (m_data.size() - m_size < n)
+				m_data.resize(std::max(m_size + n, m_data.size() * 2));
+			return m_data.data() + m_size;
+		}
+
+		void commit(std::size_t n) { m_size += n; }
+
+		void reserve(std::size_t capacity)
+		{
+			if (m_data.size() < capacity)
+				m_data.resize(capacity);
+		}
+
+		void clear() { m_size = 0; }
+		bool empty() const { return m_size == 0; }
+		std::size_t size() const { return m_size; }
+		const char* data() const { return m_data.data(); }
+		std::string_view view() const { return std::string_view(m_data.data(), m_size); }
+		std::string str() const { return std::string(view()); }
+
+	private:
+		// m_data.size() is the capacity; only the first m_size characters are in use
+		std::string m_data;
+		std::size_t m_size = 0;
+	};
+
+	namespace Impl
+	{
+		// Lends out a thread local OutputBuffer, e.g. to format a value before copying it into a std::format
+		// context, so that formatting doesn't allocate once the buffer has grown to its working size
+		// A nested borrow on the same thread (a converter that formats another value) gets its own buffer.
+		class ScratchBuffer
+		{
+		public:
+			ScratchBuffer()
+				: m_shared(!s_inUse)
+			{
+				if (m_shared)
+				{
+					s_inUse = true;
+					s_buffer.clear();
+				}
+			}
+
+			~ScratchBuffer()
+			{
+				if (m_shared)
+					s_inUse = false;
+			}
+
+			ScratchBuffer(const ScratchBuffer&) = delete;
+			ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+			OutputBuffer& get() { return m_shared ? s_buffer : m_local; }
+
+		private:
+			static inline thread_local OutputBuffer s_buffer;
+			static inline thread_local bool s_inUse = false;
+
+			bool m_shared;
+			OutputBuffer m_local;
+		};
+	}
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <Converter/BatchConvert.h>
+#include <Converter/ConverterExport.h>
+#include <Converter/OutputBuffer.h>
+#include <Converter/SmallFunction.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Parallel versions of toStrings / fromStrings for large arrays (see BatchConvert.h)
+// The values are split into chunks that run on a work-stealing thread pool shared by the process;
+// the calling thread works on chunks too. The text is exactly what toStrings writes and fromStrings accepts.
+//
+// Example usage:
+//    Converter::OutputBuffer out;
+//    Converter::parallelToStrings<double>(values, out);   // Every chunk formats into its own buffer; they are joined in order
+//
+//    std::vector<Converter::OutputBuffer> chunks;         // Or keep the chunks, e.g. to write them out with writev
+//    Converter::parallelToStrings<double>(values, chunks);
+//
+// The pool has one thread per core, less the calling thread (see ConverterInitOptions::parallelThreads).
+// Calls from inside a pool thread, and calls made while another thread is using the pool, run on the calling
+// thread alone. Inputs too small to be worth splitting, and every input when there is only one thread,
+// are converted directly.
+namespace Converter
+{
+	namespace Impl
+	{
+		// Values per chunk of parallelToStrings
+		inline constexpr std::size_t c_parallelChunkValues = 16384;
+		// Characters per chunk of parallelFromStrings; chunks are extended to the next delimiter
+		inline constexpr std::size_t c_parallelChunkBytes = 256 * 1024;
+
+		using ParallelTask = SmallFunction<void(std::size_t)>;
+
+		// Runs task(i) for every i in [0, taskCount) on the pool and the calling thread, returning once all are done
+		// Tasks must not throw
+		CONVERTER_EXPORT void parallelFor(std::size_t taskCount, const ParallelTask& task);
+
+		// Sets the number of threads (including the calling one) conversions are split across; 0 is one per core
+		// Only takes effect before the first parallel conversion
+		CONVERTER_EXPORT void setParallelThreadCount(std::size_t threadCount);
+		// The number of threads parallelFor runs on, starting the pool if needed
+		CONVERTER_EXPORT std::size_t getParallelThreadCount();
+
+		// A run of whole values of a delimited text
+		struct DelimitedChunk
+		{
+			std::string_view text;  // Without the delimiters around it
+			std::size_t firstIndex; // Index of its first value in the whole text
+			std::size_t count;      // Number of values in it; an empty text is one empty value
+		};
+
+		// Splits a non-empty str into chunks of about c_parallelChunkBytes, counting their values in parallel
+		CONVERTER_EXPORT std::vector<DelimitedChunk> splitDelimited(std::string_view str, char delimiter);
+
+		// Appends the chunks to out in order, copying them in parallel
+		CONVERTER_EXPORT void joinChunks(std::span<const OutputBuffer> chunks, OutputBuffer& out);
+	}
+
+	// Formats values into chunks of consecutive values; every chunk but the first starts with the delimiter,
+	// so writing the chunks in order writes the same text as toStrings
+	// chunks is resized to the number of chunks; passing the same vector again reuses its buffers
+	template<typename T>
+	void parallelToStrings(std::span<const T> values, std::vector<OutputBuffer>& chunks, char delimiter = ',')
+	{
+		const std::size_t chunkCount = (values.size() + Impl::c_parallelChunkValues - 1) / Impl::c_parallelChunkValues;
+		chunks.resize(chunkCount);
+		Impl::parallelFor(chunkCount, [&values, &chunks, delimiter](std::size_t chunk)
+			{
+				OutputBuffer& out = chunks[chunk];
+				out.clear();
+				if (chunk > 0)
+					out.push_back(delimiter);
+
+				const std::size_t first = chunk * Impl::c_parallelChunkValues;
+				toStrings(values.subspan(first, std::min(Impl::c_parallelChunkValues, values.size() - first)), out, delimiter);
+			});
+	}
+
+	// Appends values to out, separated by delimiter; the same text as toStrings
+	template<typename T>
+	void parallelToStrings(std::span<const T> values, OutputBuffer& out, char delimiter = ',')
+	{
+		if (values.size() <= Impl::c_parallelChunkValues || Impl::getParallelThreadCount() == 1)
+		{
+			toStrings(values, out, delimiter);
+			return;
+		}
+
+		std::vector<OutputBuffer> chunks;
+		parallelToStrings(values, chunks, delimiter);
+		Impl::joinChunks(chunks, out);
+	}
+
+	// Parses the delimited values in str into the front of values; the same results and errors as fromStrings
+	template<typename T>
+	std::expected<std::size_t, BatchError> parallelFromStrings(std::string_view str, std::span<T> values, char delimiter = ',')
+	{
+		if (str.size() <= Impl::c_parallelChunkBytes || Impl::getParallelThreadCount() == 1)
+			return fromStrings(str, values, delimiter);
+
+		const std::vector<Impl::DelimitedChunk> chunks = Impl::splitDelimited(str, delimiter);
+		std::vector<std::optional<BatchError>> errors(chunks.size());
+		Impl::parallelFor(chunks.size(), [&chunks, &errors, values, delimiter](std::size_t i)
+			{
+				const Impl::DelimitedChunk& chunk = chunks[i];
+				if (chunk.firstIndex >= values.size())
+				{
+					errors[i] = BatchError{ values.size(), ConvertError::TrailingCharacters };
+					return;
+				}
+
+				// fromStrings reads an empty text as no values at all
+				if (chunk.text.empty())
+				{
+					auto value = tryParse<T>(chunk.text);
+					if (value)
+						values[chunk.firstIndex] = std::move(*value);
+					else
+						errors[i] = BatchError{ chunk.firstIndex, value.error() };
+					return;
+				}
+
+				const std::span<T> target = values.subspan(chunk.firstIndex, std::min(chunk.count, values.size() - chunk.firstIndex));
+				auto parsed = fromStrings(chunk.text, target, delimiter);
+				if (!parsed)
+					errors[i] = BatchError{ chunk.firstIndex + parsed.error().index, parsed.error().error };
+			});
+
+		// Chunks are in order, so the first error found is the one fromStrings would have returned
+		for (const auto& error : errors)
+		{
+			if (error)
+				return std::unexpected(*error);
+		}
+		return chunks.back().firstIndex + chunks.back().count;
+	}
+}
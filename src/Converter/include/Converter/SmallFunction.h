@@ -0,0 +1,133 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Converter::Impl
+{
+	template<typename Signature>
+	class SmallFunction;
+
+	// Type erased callable that is always stored inline and never allocates
+	// Calling it is a single indirect call to a thunk that calls the stored callable directly.
+	// Callables larger than c_capacity are a compile error rather than a heap allocation.
+	template<typename R, typename... Args>
+	class SmallFunction<R(Args...)>
+	{
+	public:
+		static constexpr std::size_t c_capacity = 8 * sizeof(void*);
+
+		constexpr SmallFunction() = default;
+
+		// Captureless lambdas are stored without any state, so a SmallFunction holding one can be built at compile time
+		template<typename F>
+			requires (!std::same_as<std::remove_cvref_t<F>, SmallFunction>) && std::is_invocable_r_v<R, const std::remove_cvref_t<F>&, Args...>
+		constexpr SmallFunction(F&& func)
+		{
+			using Stored = std::remove_cvref_t<F>;
+			static_assert(sizeof(Stored) <= c_capacity, "Callable is too large for SmallFunction; capture less state");
+			static_assert(alignof(Stored) <= alignof(std::max_align_t), "Callable is over-aligned for SmallFunction");
+			static_assert(std::is_copy_constructible_v<Stored>, "SmallFunction requires a copyable callable");
+
+			if constexpr (c_stateless<Stored>)
+			{
+				m_invoke = &invokeStateless<Stored>;
+			}
+			else
+			{
+				::new (static_cast<void*>(m_storage)) Stored(std::forward<F>(func));
+				m_invoke = &invokeStored<Stored>;
+				// Function pointers and lambdas capturing trivial values are copied as bytes and need no cleanup
+				if constexpr (!std::is_trivially_copyable_v<Stored> || !std::is_trivially_destructible_v<Stored>)
+					m_ops = &c_ops<Stored>;
+			}
+		}
+
+		constexpr SmallFunction(const SmallFunction& other)
+		{
+			copyFrom(other);
+		}
+
+		constexpr SmallFunction& operator=(const SmallFunction& other)
+		{
+			if (this != &other)
+			{
+				reset();
+				copyFrom(other);
+			}
+			return *this;
+		}
+
+		constexpr ~SmallFunction()
+		{
+			reset();
+		}
+
+		R operator()(Args... args) const
+		{
+			return m_invoke(m_storage, std::forward<Args>(args)...);
+		}
+
+		constexpr explicit operator bool() const { return m_invoke != nullptr; }
+
+	private:
+		struct Ops
+		{
+			void (*copy)(void* dst, const void* src);
+			void (*destroy)(void* storage);
+		};
+
+		template<typename F>
+		static constexpr bool c_stateless = std::is_empty_v<F> && std::is_default_constructible_v<F> && std::is_trivially_copyable_v<F>;
+
+		template<typename F>
+		static R invokeStored(const void* storage, Args... args)
+		{
+			return (*static_cast<const F*>(storage))(std::forward<Args>(args)...);
+		}
+
+		template<typename F>
+		static R invokeStateless(const void*, Args... args)
+		{
+			return F{}(std::forward<Args>(args)...);
+		}
+
+		template<typename F>
+		static constexpr Ops c_ops
+		{
+			[](void* dst, const void* src) { ::new (dst) F(*static_cast<const F*>(src)); },
+			[](void* storage) { static_cast<F*>(storage)->~F(); },
+		};
+
+		constexpr void copyFrom(const SmallFunction& other)
+		{
+			if (other.m_ops)
+			{
+				other.m_ops->copy(m_storage, other.m_storage);
+			}
+			else if !consteval
+			{
+				// Stateless callables are the only ones that can be copied at compile time and have nothing to copy
+				std::memcpy(m_storage, other.m_storage, c_capacity);
+			}
+			m_invoke = other.m_invoke;
+			m_ops = other.m_ops;
+		}
+
+		constexpr void reset()
+		{
+			if (m_ops)
+				m_ops->destroy(m_storage);
+			m_invoke = nullptr;
+			m_ops = nullptr;
+		}
+
+		alignas(std::max_align_t) std::byte m_storage[c_capacity] = {};
+		R (*m_invoke)(const void*, Args...) = nullptr;
+		const Ops* m_ops = nullptr;
+	};
+}
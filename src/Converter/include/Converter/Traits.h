@@ -0,0 +1,330 @@
+#pragma once
+
+#include <Converter/Bytes.h>
+#include <Converter/ConvertError.h>
+#include <Converter/FormatSpec.h>
+#include <Converter/OutputBuffer.h>
+
+#include <Logger/Logger.h>
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+// Compile time converters
+// Specialize Converter::Traits for a type to give it a converter that is resolved at compile time:
+//
+//		template<>
+//		struct Converter::Traits<MyType>
+//		{
+//			static std::string toString(const MyType& val);
+//			static MyType fromString(const std::string& str);
+//
+//			// Optional, non-allocating forms used by the OutputBuffer / string_view overloads
+//			static void toChars(const MyType& val, Converter::OutputBuffer& out);
+//			static MyType fromChars(std::string_view str);
+//
+//			// Optional, std::format style formatting used by the FormatSpec overloads (see FormatSpec.h)
+//			static void toFormattedChars(const MyType& val, const Converter::FormatSpec& spec, Converter::OutputBuffer& out);
+//
+//			// Optional, non-throwing parse used by Converter::tryParse
+//			static std::expected<MyType, Converter::ConvertError> tryFromChars(std::string_view str);
+//
+//			// Optional, binary encoding used by getBytesForType / getBytesFromAny
+//			static void encode(const MyType& val, Converter::ByteWriter& out);
+//			static std::expected<MyType, Converter::ConvertError> decode(Converter::ByteReader& in);
+//		};
+//
+// The templated getStringForType / getTypeFromString call the traits directly (no std::any, no
+// std::function and no registry lookup). Types without traits go through the runtime registry.
+// Traits don't register a type on their own; use REGISTER_TRAITS_CONVERTER so that the
+// type erased getStringFromAny functions can find it too.
+namespace Converter
+{
+	// Primary template: no traits
+	template<typename T>
+	struct Traits
+	{
+	};
+
+	// Character types other than signed/unsigned char (which are treated as 8 bit integers)
+	template<typename T>
+	concept CharacterType = std::same_as<T, char> || std::same_as<T, wchar_t>
+		|| std::same_as<T, char8_t> || std::same_as<T, char16_t> || std::same_as<T, char32_t>;
+
+	template<typename T>
+	concept HasTraits = requires(const T& val, const std::string& str)
+	{
+		{ Traits<T>::toString(val) } -> std::same_as<std::string>;
+		{ Traits<T>::fromString(str) } -> std::same_as<T>;
+	};
+
+	// Traits that can append into an OutputBuffer and parse from a string_view
+	template<typename T>
+	concept HasCharsTraits = HasTraits<T> && requires(const T& val, OutputBuffer& out, std::string_view str)
+	{
+		{ Traits<T>::toChars(val, out) } -> std::same_as<void>;
+		{ Traits<T>::fromChars(str) } -> std::same_as<T>;
+	};
+
+	// Traits that apply a FormatSpec themselves
+	// The text of every other type is only padded to the spec's width
+	template<typename T>
+	concept HasSpecTraits = HasCharsTraits<T> && requires(const T& val, const FormatSpec& spec, OutputBuffer& out)
+	{
+		{ Traits<T>::toFormattedChars(val, spec, out) } -> std::same_as<void>;
+	};
+
+	// Traits with a non-throwing parse function
+	template<typename T>
+	concept HasTryTraits = HasTraits<T> && requires(std::string_view str)
+	{
+		{ Traits<T>::tryFromChars(str) } -> std::same_as<std::expected<T, ConvertError>>;
+	};
+
+	// Traits with a binary encoding
+	template<typename T>
+	concept HasBinaryTraits = HasTraits<T> && requires(const T& val, ByteWriter& out, ByteReader& in)
+	{
+		{ Traits<T>::encode(val, out) } -> std::same_as<void>;
+		{ Traits<T>::decode(in) } -> std::same_as<std::expected<T, ConvertError>>;
+	};
+
+	namespace Impl
+	{
+		// Unwraps a parse result for the APIs that return a plain value
+		// Failures are logged and turn into T()
+		template<typename T>
+		T valueOrLogError(std::expected<T, ConvertError> result, std::string_view str, std::string_view typeName)
+		{
+			if (!result)
+			{
+				Log::Error().log("Unable to convert \"{}\" to {}! Reason: {}", str, typeName, getStringForError(result.error()));
+				return T();
+			}
+			return std::move(*result);
+		}
+
+		// Locale independent, non-allocating (beyond the returned string) number conversion
+		// Integers are printed in base 10; floating point values use the shortest representation
+		// that parses back to the exact same value.
+		// Parsing requires the whole string to be a number.
+		template<typename T>
+		struct NumberTraits
+		{
+			// Large enough for any integer or for the shortest round-trip form of any floating point value
+			static constexpr std::size_t c_bufferSize = 64;
+
+			static std::string toString(const T& val)
+			{
+				char buffer[c_bufferSize];
+				auto [ptr, ec] = std::to_chars(buffer, buffer + c_bufferSize, val);
+				return std::string(buffer, ptr);
+			}
+
+			static T fromString(const std::string& str)
+			{
+				return fromChars(str);
+			}
+
+			static void toChars(const T& val, OutputBuffer& out)
+			{
+				char* dst = out.prepare(c_bufferSize);
+				auto [ptr, ec] = std::to_chars(dst, dst + c_bufferSize, val);
+				out.commit(static_cast<std::size_t>(ptr - dst));
+			}
+
+			static void toFormattedChars(const T& val, const FormatSpec& spec, OutputBuffer& out)
+			{
+				if constexpr (std::floating_point<T>)
+					formatFloat(val, spec, out);
+				else if constexpr (std::is_signed_v<T>)
+					formatInteger(static_cast<std::int64_t>(val), spec, out);
+				else
+					formatInteger(static_cast<std::uint64_t>(val), spec, out);
+			}
+
+			static T fromChars(std::string_view str)
+			{
+				return valueOrLogError(tryFromChars(str), str, "a number");
+			}
+
+			static std::expected<T, ConvertError> tryFromChars(std::string_view str)
+			{
+				T val{};
+				auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), val);
+				if (ec == std::errc::invalid_argument)
+					return std::unexpected(ConvertError::InvalidSyntax);
+				if (ec == std::errc::result_out_of_range)
+					return std::unexpected(ConvertError::OutOfRange);
+				if (ptr != str.data() + str.size())
+					return std::unexpected(ConvertError::TrailingCharacters);
+				return val;
+			}
+
+			// Binary: single bytes and float / double are written fixed width, other integers as
+			// (zigzag) varints and long double, which has no portable layout, as its shortest text
+			static void encode(const T& val, ByteWriter& out)
+			{
+				if constexpr (sizeof(T) == 1 || std::same_as<T, float> || std::same_as<T, double>)
+				{
+					out.writeFixed(val);
+				}
+				else if constexpr (std::floating_point<T>)
+				{
+					char buffer[c_bufferSize];
+					auto [ptr, ec] = std::to_chars(buffer, buffer + c_bufferSize, val);
+					out.writeVarint(static_cast<std::uint64_t>(ptr - buffer));
+					out.writeBytes(std::as_bytes(std::span<const char>(buffer, ptr)));
+				}
+				else if constexpr (std::is_signed_v<T>)
+				{
+					out.writeSignedVarint(val);
+				}
+				else
+				{
+					out.writeVarint(val);
+				}
+			}
+
+			static std::expected<T, ConvertError> decode(ByteReader& in)
+			{
+				if constexpr (sizeof(T) == 1 || std::same_as<T, float> || std::same_as<T, double>)
+				{
+					T val{};
+					if (!in.readFixed(val))
+						return std::unexpected(ConvertError::UnexpectedEnd);
+					return val;
+				}
+				else if constexpr (std::floating_point<T>)
+				{
+					std::uint64_t size = 0;
+					std::span<const std::byte> bytes;
+					if (!in.readVarint(size) || !in.readBytes(size, bytes))
+						return std::unexpected(ConvertError::UnexpectedEnd);
+					return tryFromChars(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+				}
+				else if constexpr (std::is_signed_v<T>)
+				{
+					std::int64_t val = 0;
+					if (!in.readSignedVarint(val))
+						return std::unexpected(ConvertError::UnexpectedEnd);
+					if (val < std::numeric_limits<T>::min() || val > std::numeric_limits<T>::max())
+						return std::unexpected(ConvertError::OutOfRange);
+					return static_cast<T>(val);
+				}
+				else
+				{
+					std::uint64_t val = 0;
+					if (!in.readVarint(val))
+						return std::unexpected(ConvertError::UnexpectedEnd);
+					if (val > std::numeric_limits<T>::max())
+						return std::unexpected(ConvertError::OutOfRange);
+					return static_cast<T>(val);
+				}
+			}
+		};
+	}
+
+	// bool is written as 1/0; "true"/"false" are also accepted when parsing
+	template<>
+	struct Traits<bool>
+	{
+		static std::string toString(const bool& val) { return val ? "1" : "0"; }
+		static bool fromString(const std::string& str) { return fromChars(str); }
+		static void toChars(const bool& val, OutputBuffer& out) { out.push_back(val ? '1' : '0'); }
+		static void toFormattedChars(const bool& val, const FormatSpec& spec, OutputBuffer& out) { Impl::formatBool(val, spec, out); }
+		static bool fromChars(std::string_view str) { return Impl::valueOrLogError(tryFromChars(str), str, "bool"); }
+		static std::expected<bool, ConvertError> tryFromChars(std::string_view str)
+		{
+			if (str == "1" || str == "true")
+				return true;
+			if (str == "0" || str == "false")
+				return false;
+			return std::unexpected(ConvertError::InvalidSyntax);
+		}
+		static void encode(const bool& val, ByteWriter& out) { out.writeByte(std::byte(val ? 1 : 0)); }
+		static std::expected<bool, ConvertError> decode(ByteReader& in)
+		{
+			std::byte byte{};
+			if (!in.readByte(byte))
+				return std::unexpected(ConvertError::UnexpectedEnd);
+			if (byte > std::byte(1))
+				return std::unexpected(ConvertError::InvalidSyntax);
+			return byte == std::byte(1);
+		}
+	};
+
+	// char is converted as a single character
+	template<>
+	struct Traits<char>
+	{
+		static std::string toString(const char& val) { return std::string(1, val); }
+		static char fromString(const std::string& str) { return fromChars(str); }
+		static void toChars(const char& val, OutputBuffer& out) { out.push_back(val); }
+		static void toFormattedChars(const char& val, const FormatSpec& spec, OutputBuffer& out) { Impl::formatChar(val, spec, out); }
+		static char fromChars(std::string_view str) { return Impl::valueOrLogError(tryFromChars(str), str, "char"); }
+		static std::expected<char, ConvertError> tryFromChars(std::string_view str)
+		{
+			if (str.empty())
+				return std::unexpected(ConvertError::InvalidSyntax);
+			if (str.size() > 1)
+				return std::unexpected(ConvertError::TrailingCharacters);
+			return str.front();
+		}
+		static void encode(const char& val, ByteWriter& out) { out.writeFixed(val); }
+		static std::expected<char, ConvertError> decode(ByteReader& in)
+		{
+			char val = 0;
+			if (!in.readFixed(val))
+				return std::unexpected(ConvertError::UnexpectedEnd);
+			return val;
+		}
+	};
+
+	template<typename T>
+		requires std::integral<T> && (!std::same_as<T, bool>) && (!CharacterType<T>)
+	struct Traits<T> : Impl::NumberTraits<T>
+	{
+	};
+
+	template<std::floating_point T>
+	struct Traits<T> : Impl::NumberTraits<T>
+	{
+	};
+
+	template<>
+	struct Traits<std::string>
+	{
+		static std::string toString(const std::string& val) { return val; }
+		static std::string fromString(const std::string& str) { return str; }
+		static void toChars(const std::string& val, OutputBuffer& out) { out.append(val); }
+		static void toFormattedChars(const std::string& val, const FormatSpec& spec, OutputBuffer& out) { Impl::formatString(val, spec, out); }
+		static std::string fromChars(std::string_view str) { return std::string(str); }
+		static std::expected<std::string, ConvertError> tryFromChars(std::string_view str) { return std::string(str); }
+
+		// Varint length followed by the characters
+		static void encode(const std::string& val, ByteWriter& out)
+		{
+			out.writeVarint(val.size());
+			out.writeBytes(std::as_bytes(std::span<const char>(val)));
+		}
+
+		static std::expected<std::string, ConvertError> decode(ByteReader& in)
+		{
+			std::uint64_t size = 0;
+			std::span<const std::byte> bytes;
+			if (!in.readVarint(size) || !in.readBytes(size, bytes))
+				return std::unexpected(ConvertError::UnexpectedEnd);
+			return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+		}
+	};
+}
@@ -0,0 +1,306 @@
+#include <Converter/BatchConvert.h>
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <limits>
+#include <type_traits>
+
+#include "SimdSupport.h"
+
+namespace
+{
+	using Converter::BatchError;
+	using Converter::ConvertError;
+	using Converter::Impl::getKernelLevel;
+	using Converter::Impl::KernelLevel;
+
+	// Longest integer text ("-9223372036854775808" or "18446744073709551615") plus the delimiter
+	constexpr std::size_t c_maxFieldSize = 21;
+	// The SIMD kernels store 16 bytes at a time, past the end of shorter values
+	constexpr std::size_t c_storeSlack = 16;
+
+	constexpr std::uint64_t c_pow8 = 100000000;
+	constexpr std::uint64_t c_pow16 = c_pow8 * c_pow8;
+
+	// Range checks a parsed magnitude the same way std::from_chars does
+	template<typename T>
+	std::expected<T, ConvertError> fromMagnitude(std::uint64_t magnitude, bool negative)
+	{
+		using Unsigned = std::make_unsigned_t<T>;
+		const std::uint64_t limit = static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+		if (magnitude > limit)
+			return std::unexpected(ConvertError::OutOfRange);
+		return negative ? static_cast<T>(Unsigned(0) - static_cast<Unsigned>(magnitude)) : static_cast<T>(magnitude);
+	}
+
+	template<typename T>
+	std::uint64_t getMagnitude(T val, bool& negative)
+	{
+		negative = std::is_signed_v<T> && val < 0;
+		return negative ? std::uint64_t(0) - static_cast<std::uint64_t>(val) : static_cast<std::uint64_t>(val);
+	}
+
+	// Parses one field the slow way; pos is moved to the delimiter or the end
+	template<typename T>
+	std::expected<T, ConvertError> parseFieldScalar(const char*& pos, const char* end, char delimiter)
+	{
+		const char* fieldEnd = std::find(pos, end, delimiter);
+		auto value = Converter::Traits<T>::tryFromChars(std::string_view(pos, static_cast<std::size_t>(fieldEnd - pos)));
+		pos = fieldEnd;
+		return value;
+	}
+
+	template<typename T>
+	void formatScalar(std::span<const T> values, Converter::OutputBuffer& out, char delimiter)
+	{
+		char* const start = out.prepare(values.size() * c_maxFieldSize);
+		char* dst = start;
+		for (std::size_t i = 0; i < values.size(); i++)
+		{
+			if (i > 0)
+				*dst++ = delimiter;
+			dst = std::to_chars(dst, dst + c_maxFieldSize, values[i]).ptr;
+		}
+		out.commit(static_cast<std::size_t>(dst - start));
+	}
+
+	template<typename T>
+	std::expected<std::size_t, BatchError> parseScalar(std::string_view str, std::span<T> values, char delimiter)
+	{
+		if (str.empty())
+			return 0;
+
+		const char* pos = str.data();
+		const char* const end = pos + str.size();
+		std::size_t count = 0;
+		while (true)
+		{
+			if (count == values.size())
+				return std::unexpected(BatchError{ count, ConvertError::TrailingCharacters });
+
+			auto value = parseFieldScalar<T>(pos, end, delimiter);
+			if (!value)
+				return std::unexpected(BatchError{ count, value.error() });
+			values[count++] = *value;
+
+			if (pos == end)
+				return count;
+			pos++;
+		}
+	}
+
+#if defined(CONVERTER_X86)
+	// Eight decimal digits of value (< 10^8) as 16 bit lanes, most significant first
+	// Splits value into two halves of four digits, then divides each half by 1000, 100, 10 and 1 at once
+	// with fixed point reciprocals, and subtracts ten times the previous quotient from each to leave one digit.
+	CONVERTER_TARGET_SSE41 inline __m128i toDigitsSse41(std::uint32_t value)
+	{
+		const __m128i abcdefgh = _mm_cvtsi32_si128(static_cast<int>(value));
+		// abcd = abcdefgh / 10000, efgh = abcdefgh % 10000
+		const __m128i abcd = _mm_srli_epi64(_mm_mul_epu32(abcdefgh, _mm_set1_epi32(static_cast<int>(0xd1b71759))), 45);
+		const __m128i efgh = _mm_sub_epi32(abcdefgh, _mm_mul_epu32(abcd, _mm_set1_epi32(10000)));
+		// [abcd * 4, efgh * 4] spread to [abcd * 4 (x4), efgh * 4 (x4)]
+		const __m128i halves = _mm_slli_epi64(_mm_unpacklo_epi16(abcd, efgh), 2);
+		const __m128i pairs = _mm_unpacklo_epi16(halves, halves);
+		const __m128i spread = _mm_unpacklo_epi32(pairs, pairs);
+		// [a, ab, abc, abcd, e, ef, efg, efgh]
+		const __m128i quotients = _mm_mulhi_epu16(_mm_mulhi_epu16(spread, _mm_setr_epi16(8389, 5243, 13108, -32768, 8389, 5243, 13108, -32768)),
+			_mm_setr_epi16(1 << 7, 1 << 11, 1 << 13, -32768, 1 << 7, 1 << 11, 1 << 13, -32768));
+		// [a, b, c, d, e, f, g, h]
+		return _mm_sub_epi16(quotients, _mm_slli_epi64(_mm_mullo_epi16(quotients, _mm_set1_epi16(10)), 16));
+	}
+
+	// Writes eight digits, without their leading zeros if strip is set (but at least one digit)
+	// Stores 16 bytes at dst
+	CONVERTER_TARGET_SSE41 inline char* storeDigitsSse41(__m128i digits, char* dst, bool strip)
+	{
+		const __m128i zero = _mm_set1_epi8('0');
+		const __m128i chars = _mm_add_epi8(_mm_packus_epi16(digits, digits), zero);
+		int skip = 0;
+		if (strip)
+		{
+			const unsigned zeros = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, zero)));
+			skip = std::countr_one(zeros & 0x7f);
+		}
+		const __m128i shift = _mm_add_epi8(_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm_set1_epi8(static_cast<char>(skip)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_shuffle_epi8(chars, shift));
+		return dst + 8 - skip;
+	}
+
+	CONVERTER_TARGET_SSE41 inline char* formatMagnitudeSse41(std::uint64_t val, char* dst)
+	{
+		if (val < c_pow8)
+			return storeDigitsSse41(toDigitsSse41(static_cast<std::uint32_t>(val)), dst, true);
+
+		if (val >= c_pow16)
+		{
+			dst = std::to_chars(dst, dst + c_maxFieldSize, val / c_pow16).ptr;
+			val %= c_pow16;
+			dst = storeDigitsSse41(toDigitsSse41(static_cast<std::uint32_t>(val / c_pow8)), dst, false);
+		}
+		else
+		{
+			dst = storeDigitsSse41(toDigitsSse41(static_cast<std::uint32_t>(val / c_pow8)), dst, true);
+		}
+		return storeDigitsSse41(toDigitsSse41(static_cast<std::uint32_t>(val % c_pow8)), dst, false);
+	}
+
+	template<typename T>
+	CONVERTER_TARGET_SSE41 void formatSse41(std::span<const T> values, Converter::OutputBuffer& out, char delimiter)
+	{
+		char* const start = out.prepare(values.size() * c_maxFieldSize + c_storeSlack);
+		char* dst = start;
+		for (std::size_t i = 0; i < values.size(); i++)
+		{
+			if (i > 0)
+				*dst++ = delimiter;
+			bool negative = false;
+			const std::uint64_t magnitude = getMagnitude(values[i], negative);
+			// The sign is always written and only kept for negative values, so there is no branch
+			*dst = '-';
+			dst = formatMagnitudeSse41(magnitude, dst + negative);
+		}
+		out.commit(static_cast<std::size_t>(dst - start));
+	}
+
+	// Digit bytes (0-9 rather than '0'-'9') that are 1 at the start of chunk
+	CONVERTER_TARGET_SSE41 inline std::size_t countDigitsSse41(__m128i chunk)
+	{
+		// As unsigned bytes everything but a digit is larger than 9
+		const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(chunk, _mm_set1_epi8(9)), chunk);
+		return static_cast<std::size_t>(std::countr_one(static_cast<unsigned>(_mm_movemask_epi8(isDigit))));
+	}
+
+	// The value of the last 16 - skip digit bytes of chunk
+	// The digits are moved to the end of the register behind zeros, then neighbouring digits are
+	// combined into 2, 4 and 8 digit numbers with multiply-adds.
+	CONVERTER_TARGET_SSE41 inline std::uint64_t combineDigitsSse41(__m128i chunk, std::size_t skip)
+	{
+		// Indexes with the high bit set make the shuffle write zeros
+		const __m128i align = _mm_sub_epi8(_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm_set1_epi8(static_cast<char>(skip)));
+		const __m128i digits = _mm_shuffle_epi8(chunk, align);
+		const __m128i pairs = _mm_maddubs_epi16(digits, _mm_set1_epi16(0x010a));
+		const __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00010064));
+		const __m128i octets = _mm_madd_epi16(_mm_packus_epi32(quads, quads), _mm_set1_epi32(0x00012710));
+		return static_cast<std::uint64_t>(_mm_cvtsi128_si32(octets)) * c_pow8 + static_cast<std::uint32_t>(_mm_extract_epi32(octets, 1));
+	}
+
+	// Parses the run of up to 20 digits at src, which must have 16 readable bytes (32 for more than 15 digits)
+	// Returns false if there are no digits, too many, or the value doesn't fit in 64 bits; the scalar parser handles those.
+	CONVERTER_TARGET_SSE41 inline bool parseDigitsSse41(const char* src, const char* end, std::uint64_t& value, std::size_t& length)
+	{
+		const __m128i chunk = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), _mm_set1_epi8('0'));
+		length = countDigitsSse41(chunk);
+		if (length == 0)
+			return false;
+		if (length < 16)
+		{
+			value = combineDigitsSse41(chunk, 16 - length);
+			return true;
+		}
+
+		// The first 1-4 digits of 17-20 digit values are added by hand, the last 16 with the kernel
+		if (end - src < 32)
+			return false;
+		const std::size_t extra = countDigitsSse41(_mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16)), _mm_set1_epi8('0')));
+		if (extra > 4)
+			return false;
+
+		std::uint64_t high = 0;
+		for (std::size_t i = 0; i < extra; i++)
+			high = high * 10 + static_cast<std::uint64_t>(src[i] - '0');
+		const std::uint64_t low = combineDigitsSse41(_mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + extra)), _mm_set1_epi8('0')), 0);
+		if (high > (std::numeric_limits<std::uint64_t>::max() - low) / c_pow16)
+			return false;
+
+		value = high * c_pow16 + low;
+		length = 16 + extra;
+		return true;
+	}
+
+	template<typename T>
+	CONVERTER_TARGET_SSE41 std::expected<std::size_t, BatchError> parseSse41(std::string_view str, std::span<T> values, char delimiter)
+	{
+		if (str.empty())
+			return 0;
+
+		const char* pos = str.data();
+		const char* const end = pos + str.size();
+		std::size_t count = 0;
+		while (true)
+		{
+			if (count == values.size())
+				return std::unexpected(BatchError{ count, ConvertError::TrailingCharacters });
+
+			// Fields the kernel can't read or that don't end at a delimiter take the scalar path for its exact errors
+			const bool negative = std::is_signed_v<T> && pos != end && *pos == '-';
+			const char* digits = pos + negative;
+			std::uint64_t magnitude = 0;
+			std::size_t length = 0;
+			std::expected<T, ConvertError> value;
+			if (end - digits >= 16 && parseDigitsSse41(digits, end, magnitude, length) && digits + length != end && digits[length] == delimiter)
+			{
+				value = fromMagnitude<T>(magnitude, negative);
+				pos = digits + length;
+			}
+			else
+			{
+				value = parseFieldScalar<T>(pos, end, delimiter);
+			}
+
+			if (!value)
+				return std::unexpected(BatchError{ count, value.error() });
+			values[count++] = *value;
+
+			if (pos == end)
+				return count;
+			pos++;
+		}
+	}
+#endif
+
+	template<typename T>
+	void formatDispatch(std::span<const T> values, Converter::OutputBuffer& out, char delimiter)
+	{
+		switch (getKernelLevel())
+		{
+#if defined(CONVERTER_X86)
+		case KernelLevel::Sse41:
+			formatSse41(values, out, delimiter);
+			return;
+#endif
+		default:
+			formatScalar(values, out, delimiter);
+			return;
+		}
+	}
+
+	template<typename T>
+	std::expected<std::size_t, BatchError> parseDispatch(std::string_view str, std::span<T> values, char delimiter)
+	{
+#if defined(CONVERTER_X86)
+		if (getKernelLevel() == KernelLevel::Sse41)
+			return parseSse41(str, values, delimiter);
+#endif
+		return parseScalar(str, values, delimiter);
+	}
+}
+
+namespace Converter::Impl
+{
+	void formatIntegers(std::span<const std::int32_t> values, OutputBuffer& out, char delimiter) { formatDispatch(values, out, delimiter); }
+	void formatIntegers(std::span<const std::uint32_t> values, OutputBuffer& out, char delimiter) { formatDispatch(values, out, delimiter); }
+	void formatIntegers(std::span<const std::int64_t> values, OutputBuffer& out, char delimiter) { formatDispatch(values, out, delimiter); }
+	void formatIntegers(std::span<const std::uint64_t> values, OutputBuffer& out, char delimiter) { formatDispatch(values, out, delimiter); }
+
+	std::expected<std::size_t, BatchError> parseIntegers(std::string_view str, std::span<std::int32_t> values, char delimiter) { return parseDispatch(str, values, delimiter); }
+	std::expected<std::size_t, BatchError> parseIntegers(std::string_view str, std::span<std::uint32_t> values, char delimiter) { return parseDispatch(str, values, delimiter); }
+	std::expected<std::size_t, BatchError> parseIntegers(std::string_view str, std::span<std::int64_t> values, char delimiter) { return parseDispatch(str, values, delimiter); }
+	std::expected<std::size_t, BatchError> parseIntegers(std::string_view str, std::span<std::uint64_t> values, char delimiter) { return parseDispatch(str, values, delimiter); }
+
+	std::string_view getBatchKernelName()
+	{
+		return getKernelLevelName(getKernelLevel());
+	}
+}
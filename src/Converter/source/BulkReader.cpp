@@ -0,0 +1,81 @@
+#include <Converter/BulkReader.h>
+
+#include <algorithm>
+
+namespace Converter
+{
+	RowSplitter::RowSplitter(std::istream& stream, const BulkOptions& options)
+		: m_stream(&stream)
+		, m_options(options)
+	{
+		m_buffer.resize(std::max<std::size_t>(m_options.chunkSize, 1));
+	}
+
+	RowSplitter::RowSplitter(std::string_view data, const BulkOptions& options)
+		: m_options(options)
+		, m_pending(data)
+	{
+	}
+
+	bool RowSplitter::nextRow(std::vector<std::string_view>& fields)
+	{
+		std::string_view line;
+		do
+		{
+			if (!nextLine(line))
+				return false;
+		} while (m_line <= m_options.skipLines);
+
+		fields.clear();
+		while (true)
+		{
+			const std::size_t end = line.find(m_options.delimiter);
+			fields.push_back(line.substr(0, end));
+			if (end == std::string_view::npos)
+				break;
+			line.remove_prefix(end + 1);
+		}
+
+		return true;
+	}
+
+	bool RowSplitter::nextLine(std::string_view& line)
+	{
+		std::size_t end = m_pending.find('\n');
+		while (end == std::string_view::npos && fill())
+			end = m_pending.find('\n');
+
+		if (m_pending.empty())
+			return false;
+
+		// The last line may have no line break
+		line = m_pending.substr(0, end);
+		m_pending.remove_prefix(end == std::string_view::npos ? m_pending.size() : end + 1);
+		if (!line.empty() && line.back() == '\r')
+			line.remove_suffix(1);
+
+		m_line++;
+		return true;
+	}
+
+	// Reads another chunk from the stream after the pending input
+	// Returns false if there is no stream or it has no more data
+	bool RowSplitter::fill()
+	{
+		if (!m_stream || !*m_stream)
+			return false;
+
+		// Move the partial line to the front and keep room for a whole chunk after it
+		// The buffer only keeps growing for lines longer than a chunk
+		const std::size_t pending = m_pending.size();
+		std::copy(m_pending.begin(), m_pending.end(), m_buffer.begin());
+		if (m_buffer.size() - pending < m_options.chunkSize)
+			m_buffer.resize(std::max(m_buffer.size() * 2, pending + m_options.chunkSize));
+
+		m_stream->read(m_buffer.data() + pending, static_cast<std::streamsize>(m_buffer.size() - pending));
+		const std::size_t read = static_cast<std::size_t>(m_stream->gcount());
+		m_pending = std::string_view(m_buffer.data(), pending + read);
+
+		return read > 0;
+	}
+}
@@ -0,0 +1,345 @@
+#include <Converter/ByteEncoding.h>
+
+#include <array>
+#include <cstring>
+
+#include "SimdSupport.h"
+
+namespace
+{
+	using Converter::ConvertError;
+	using Converter::Impl::getKernelLevel;
+	using Converter::Impl::KernelLevel;
+
+	constexpr char c_hexDigits[] = "0123456789abcdef";
+	constexpr char c_base64Digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	// Marks characters outside of an alphabet in the decode tables
+	constexpr std::uint8_t c_invalid = 0xff;
+
+	// Both characters of every byte, so encoding is one load per byte
+	constexpr auto c_hexPairs = []()
+		{
+			std::array<std::array<char, 2>, 256> pairs{};
+			for (std::size_t i = 0; i < pairs.size(); i++)
+				pairs[i] = { c_hexDigits[i >> 4], c_hexDigits[i & 0xf] };
+			return pairs;
+		}();
+
+	constexpr auto c_hexValues = []()
+		{
+			std::array<std::uint8_t, 256> values{};
+			values.fill(c_invalid);
+			for (std::uint8_t i = 0; i < 16; i++)
+			{
+				values[static_cast<unsigned char>(c_hexDigits[i])] = i;
+				if (i >= 10)
+					values[static_cast<unsigned char>('A' + i - 10)] = i;
+			}
+			return values;
+		}();
+
+	constexpr auto c_base64Values = []()
+		{
+			std::array<std::uint8_t, 256> values{};
+			values.fill(c_invalid);
+			for (std::uint8_t i = 0; i < 64; i++)
+				values[static_cast<unsigned char>(c_base64Digits[i])] = i;
+			return values;
+		}();
+
+	std::uint8_t toByte(std::byte byte) { return static_cast<std::uint8_t>(byte); }
+	std::uint8_t hexValue(char c) { return c_hexValues[static_cast<unsigned char>(c)]; }
+	std::uint8_t base64Value(char c) { return c_base64Values[static_cast<unsigned char>(c)]; }
+
+	// The scalar kernels take over wherever the SIMD ones stop, so they start at a byte / character offset
+
+	void encodeHexScalar(const std::byte* src, std::size_t count, char* dst)
+	{
+		for (std::size_t i = 0; i < count; i++, dst += 2)
+			std::memcpy(dst, c_hexPairs[toByte(src[i])].data(), 2);
+	}
+
+	bool decodeHexScalar(const char* src, std::size_t count, std::byte* dst)
+	{
+		for (std::size_t i = 0; i < count; i++, src += 2)
+		{
+			const std::uint8_t high = hexValue(src[0]);
+			const std::uint8_t low = hexValue(src[1]);
+			// Valid values are 4 bits; c_invalid has the top bits set
+			if ((high | low) & 0xf0)
+				return false;
+			dst[i] = static_cast<std::byte>((high << 4) | low);
+		}
+		return true;
+	}
+
+	// Only whole groups of 3 bytes; the padded tail is written by encodeBase64Tail
+	void encodeBase64Scalar(const std::byte* src, std::size_t groups, char* dst)
+	{
+		for (std::size_t i = 0; i < groups; i++, src += 3, dst += 4)
+		{
+			const std::uint32_t bits = (toByte(src[0]) << 16) | (toByte(src[1]) << 8) | toByte(src[2]);
+			dst[0] = c_base64Digits[bits >> 18];
+			dst[1] = c_base64Digits[(bits >> 12) & 0x3f];
+			dst[2] = c_base64Digits[(bits >> 6) & 0x3f];
+			dst[3] = c_base64Digits[bits & 0x3f];
+		}
+	}
+
+	void encodeBase64Tail(const std::byte* src, std::size_t count, char* dst)
+	{
+		if (count == 0)
+			return;
+
+		const std::uint32_t bits = (toByte(src[0]) << 16) | (count > 1 ? toByte(src[1]) << 8 : 0);
+		dst[0] = c_base64Digits[bits >> 18];
+		dst[1] = c_base64Digits[(bits >> 12) & 0x3f];
+		dst[2] = count > 1 ? c_base64Digits[(bits >> 6) & 0x3f] : '=';
+		dst[3] = '=';
+	}
+
+	// Only whole, unpadded groups of 4 characters
+	bool decodeBase64Scalar(const char* src, std::size_t groups, std::byte* dst)
+	{
+		for (std::size_t i = 0; i < groups; i++, src += 4, dst += 3)
+		{
+			const std::uint8_t a = base64Value(src[0]);
+			const std::uint8_t b = base64Value(src[1]);
+			const std::uint8_t c = base64Value(src[2]);
+			const std::uint8_t d = base64Value(src[3]);
+			// Valid values are 6 bits; c_invalid has the top bits set
+			if ((a | b | c | d) & 0xc0)
+				return false;
+
+			const std::uint32_t bits = (a << 18) | (b << 12) | (c << 6) | d;
+			dst[0] = static_cast<std::byte>(bits >> 16);
+			dst[1] = static_cast<std::byte>(bits >> 8);
+			dst[2] = static_cast<std::byte>(bits);
+		}
+		return true;
+	}
+
+	// The last group of a padded text: "xx==" is one byte and "xxx=" two
+	// The bits past the last byte must be zero so that no two texts decode to the same bytes
+	bool decodeBase64Tail(const char* src, std::size_t padding, std::byte* dst)
+	{
+		const std::uint8_t a = base64Value(src[0]);
+		const std::uint8_t b = base64Value(src[1]);
+		const std::uint8_t c = padding == 1 ? base64Value(src[2]) : 0;
+		if ((a | b | c) & 0xc0)
+			return false;
+
+		const std::uint32_t bits = (a << 18) | (b << 12) | (c << 6);
+		dst[0] = static_cast<std::byte>(bits >> 16);
+		if (padding == 2)
+			return (bits & 0xffff) == 0;
+
+		dst[1] = static_cast<std::byte>(bits >> 8);
+		return (bits & 0xff) == 0;
+	}
+
+#if defined(CONVERTER_X86)
+	// 16 bytes -> 32 characters: each nibble selects its digit with one pshufb
+	CONVERTER_TARGET_SSE41 std::size_t encodeHexSse41(const std::byte* src, std::size_t count, char* dst)
+	{
+		const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c_hexDigits));
+		const __m128i lowMask = _mm_set1_epi8(0x0f);
+
+		std::size_t i = 0;
+		for (; i + 16 <= count; i += 16, dst += 32)
+		{
+			const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			const __m128i high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), lowMask));
+			const __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, lowMask));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi8(high, low));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_unpackhi_epi8(high, low));
+		}
+		return i;
+	}
+
+	// Digit values of 16 hex characters, with valid cleared if any of them isn't a hex digit
+	CONVERTER_TARGET_SSE41 inline __m128i hexValuesSse41(__m128i chars, __m128i& valid)
+	{
+		// Unsigned range checks: c - '0' <= 9 for digits and (c | 0x20) - 'a' <= 5 for letters of either case
+		const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+		const __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+		const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+		const __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+
+		valid = _mm_and_si128(valid, _mm_or_si128(isDigit, isLetter));
+		return _mm_blendv_epi8(_mm_add_epi8(letter, _mm_set1_epi8(10)), digit, isDigit);
+	}
+
+	// 32 characters -> 16 bytes; stops at the first block with an invalid character and leaves it to the scalar kernel
+	CONVERTER_TARGET_SSE41 std::size_t decodeHexSse41(const char* src, std::size_t count, std::byte* dst)
+	{
+		// maddubs multiplies the high digit of each pair by 16 and adds the low one
+		const __m128i weights = _mm_set1_epi16(0x0110);
+
+		std::size_t i = 0;
+		for (; i + 16 <= count; i += 16, src += 32)
+		{
+			__m128i valid = _mm_set1_epi8(-1);
+			const __m128i first = hexValuesSse41(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), valid);
+			const __m128i second = hexValuesSse41(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16)), valid);
+			if (_mm_movemask_epi8(valid) != 0xffff)
+				break;
+
+			const __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(first, weights), _mm_maddubs_epi16(second, weights));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), bytes);
+		}
+		return i;
+	}
+
+	// 12 bytes -> 16 characters (W. Muła, "Base64 encoding with SIMD instructions")
+	// Reads 16 bytes per block, so it stops while at least 4 bytes are left; returns the number of whole groups encoded
+	CONVERTER_TARGET_SSE41 std::size_t encodeBase64Sse41(const std::byte* src, std::size_t count, char* dst)
+	{
+		// Splits every 3 bytes into four 6 bit indices, one per byte
+		const __m128i spread = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+		// Maps an index range selector (see below) to the offset from the index to its character
+		const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+		std::size_t group = 0;
+		for (; group * 3 + 16 <= count; group += 4, src += 12, dst += 16)
+		{
+			const __m128i bytes = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), spread);
+			const __m128i high = _mm_mulhi_epu16(_mm_and_si128(bytes, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+			const __m128i low = _mm_mullo_epi16(_mm_and_si128(bytes, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+			const __m128i indices = _mm_or_si128(high, low);
+
+			// Selector: 0 for a-z, 1-10 for 0-9, 11 for '+', 12 for '/' and 13 for A-Z
+			__m128i selector = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+			selector = _mm_or_si128(selector, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+			const __m128i chars = _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, selector));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), chars);
+		}
+		return group;
+	}
+
+	// 16 characters -> 12 bytes (W. Muła and D. Lemire, "Faster Base64 Encoding and Decoding Using AVX2 Instructions",
+	// on 16 byte registers); stops at the first block with an invalid character and leaves it to the scalar kernel
+	// Returns the number of whole groups decoded
+	CONVERTER_TARGET_SSE41 std::size_t decodeBase64Sse41(const char* src, std::size_t groups, std::byte* dst)
+	{
+		// A character is valid when the bits selected by its low and high nibbles don't overlap
+		const __m128i lowBits = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+		const __m128i highBits = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+		// Offset from a character to its value by high nibble; '/' shares its nibble with '+' and is moved to slot 1
+		const __m128i offsets = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+		const __m128i lowMask = _mm_set1_epi8(0x0f);
+		// Packs four 6 bit values into 3 bytes per 32 bit lane, then moves the bytes to the front in order
+		const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+		std::size_t group = 0;
+		for (; group + 4 <= groups; group += 4, src += 16, dst += 12)
+		{
+			const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+			const __m128i high = _mm_and_si128(_mm_srli_epi32(chars, 4), lowMask);
+			const __m128i low = _mm_and_si128(chars, lowMask);
+			if (!_mm_testz_si128(_mm_shuffle_epi8(lowBits, low), _mm_shuffle_epi8(highBits, high)))
+				break;
+
+			const __m128i isSlash = _mm_cmpeq_epi8(chars, _mm_set1_epi8('/'));
+			const __m128i values = _mm_add_epi8(chars, _mm_shuffle_epi8(offsets, _mm_add_epi8(isSlash, high)));
+
+			const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+			const __m128i bytes = _mm_shuffle_epi8(_mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000)), pack);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst), bytes);
+			const std::uint32_t last = static_cast<std::uint32_t>(_mm_extract_epi32(bytes, 2));
+			std::memcpy(dst + 8, &last, 4);
+		}
+		return group;
+	}
+#endif
+
+	void encodeHex(std::span<const std::byte> bytes, Converter::OutputBuffer& out)
+	{
+		char* dst = out.prepare(bytes.size() * 2);
+		std::size_t done = 0;
+#if defined(CONVERTER_X86)
+		if (getKernelLevel() == KernelLevel::Sse41)
+			done = encodeHexSse41(bytes.data(), bytes.size(), dst);
+#endif
+		encodeHexScalar(bytes.data() + done, bytes.size() - done, dst + done * 2);
+		out.commit(bytes.size() * 2);
+	}
+
+	void encodeBase64(std::span<const std::byte> bytes, Converter::OutputBuffer& out)
+	{
+		const std::size_t size = Converter::getEncodedSize(Converter::ByteEncoding::Base64, bytes.size());
+		const std::size_t groups = bytes.size() / 3;
+		char* dst = out.prepare(size);
+		std::size_t done = 0;
+#if defined(CONVERTER_X86)
+		if (getKernelLevel() == KernelLevel::Sse41)
+			done = encodeBase64Sse41(bytes.data(), bytes.size(), dst);
+#endif
+		encodeBase64Scalar(bytes.data() + done * 3, groups - done, dst + done * 4);
+		encodeBase64Tail(bytes.data() + groups * 3, bytes.size() - groups * 3, dst + groups * 4);
+		out.commit(size);
+	}
+
+	std::expected<std::size_t, ConvertError> decodeHex(std::string_view str, std::span<std::byte> out)
+	{
+		if (str.size() % 2 != 0)
+			return std::unexpected(ConvertError::InvalidSyntax);
+
+		const std::size_t count = str.size() / 2;
+		if (count > out.size())
+			return std::unexpected(ConvertError::OutOfRange);
+
+		std::size_t done = 0;
+#if defined(CONVERTER_X86)
+		if (getKernelLevel() == KernelLevel::Sse41)
+			done = decodeHexSse41(str.data(), count, out.data());
+#endif
+		if (!decodeHexScalar(str.data() + done * 2, count - done, out.data() + done))
+			return std::unexpected(ConvertError::InvalidSyntax);
+		return count;
+	}
+
+	std::expected<std::size_t, ConvertError> decodeBase64(std::string_view str, std::span<std::byte> out)
+	{
+		if (str.size() % 4 != 0)
+			return std::unexpected(ConvertError::InvalidSyntax);
+
+		const std::size_t padding = str.ends_with("==") ? 2 : str.ends_with('=') ? 1 : 0;
+		const std::size_t count = str.size() / 4 * 3 - padding;
+		if (count > out.size())
+			return std::unexpected(ConvertError::OutOfRange);
+
+		// The padded group is decoded on its own; '=' anywhere else is an invalid character
+		const std::size_t groups = str.size() / 4 - (padding ? 1 : 0);
+		std::size_t done = 0;
+#if defined(CONVERTER_X86)
+		if (getKernelLevel() == KernelLevel::Sse41)
+			done = decodeBase64Sse41(str.data(), groups, out.data());
+#endif
+		if (!decodeBase64Scalar(str.data() + done * 4, groups - done, out.data() + done * 3))
+			return std::unexpected(ConvertError::InvalidSyntax);
+		if (padding && !decodeBase64Tail(str.data() + groups * 4, padding, out.data() + groups * 3))
+			return std::unexpected(ConvertError::InvalidSyntax);
+		return count;
+	}
+}
+
+namespace Converter
+{
+	void encodeBytes(ByteEncoding encoding, std::span<const std::byte> bytes, OutputBuffer& out)
+	{
+		if (encoding == ByteEncoding::Hex)
+			encodeHex(bytes, out);
+		else
+			encodeBase64(bytes, out);
+	}
+
+	std::expected<std::size_t, ConvertError> decodeBytes(ByteEncoding encoding, std::string_view str, std::span<std::byte> out)
+	{
+		if (encoding == ByteEncoding::Hex)
+			return decodeHex(str, out);
+		return decodeBase64(str, out);
+	}
+}
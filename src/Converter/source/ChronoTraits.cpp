@@ -0,0 +1,487 @@
+#include <Converter/ChronoTraits.h>
+
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+	using Converter::ConvertError;
+	using Converter::Impl::IsoDuration;
+	using Converter::Impl::IsoTimestamp;
+
+	// Longest text of any value: a sign, 20 digit days and every time component, or a 9+ digit year with a fraction and offset
+	constexpr std::size_t c_maxTextSize = 64;
+	// Enough for every year a 64 bit count of seconds can reach (about 2.9e11)
+	constexpr std::size_t c_maxYearDigits = 12;
+	constexpr std::int64_t c_maxSeconds = std::numeric_limits<std::int64_t>::max();
+	constexpr std::int64_t c_minSeconds = std::numeric_limits<std::int64_t>::min();
+
+	constexpr auto c_twoDigits = []()
+		{
+			std::array<char, 200> digits{};
+			for (std::size_t i = 0; i < 100; i++)
+			{
+				digits[i * 2] = static_cast<char>('0' + i / 10);
+				digits[i * 2 + 1] = static_cast<char>('0' + i % 10);
+			}
+			return digits;
+		}();
+
+	char* writeTwoDigits(unsigned val, char* dst)
+	{
+		std::memcpy(dst, &c_twoDigits[val * 2], 2);
+		return dst + 2;
+	}
+
+	bool isDigit(char c)
+	{
+		return static_cast<unsigned char>(c - '0') < 10;
+	}
+
+	// Reads exactly count digits from the front of rest
+	bool readDigits(std::string_view& rest, std::size_t count, unsigned& val)
+	{
+		if (rest.size() < count)
+			return false;
+
+		val = 0;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			if (!isDigit(rest[i]))
+				return false;
+			val = val * 10 + static_cast<unsigned>(rest[i] - '0');
+		}
+		rest.remove_prefix(count);
+		return true;
+	}
+
+	bool consume(std::string_view& rest, char c)
+	{
+		if (rest.empty() || rest.front() != c)
+			return false;
+		rest.remove_prefix(1);
+		return true;
+	}
+
+	// Proleptic Gregorian calendar conversions in 64 bits (H. Hinnant, "chrono-Compatible Low-Level Date Algorithms")
+	// Unlike std::chrono::year they work for every year a 64 bit count of seconds can reach
+	struct CivilDate
+	{
+		std::int64_t year;
+		unsigned month;
+		unsigned day;
+	};
+
+	std::int64_t getDaysFromCivil(const CivilDate& date)
+	{
+		const std::int64_t year = date.year - (date.month <= 2 ? 1 : 0);
+		const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+		const std::int64_t yearOfEra = year - era * 400;
+		const std::int64_t dayOfYear = (153 * (date.month > 2 ? date.month - 3 : date.month + 9) + 2) / 5 + date.day - 1;
+		const std::int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+		return era * 146097 + dayOfEra - 719468;
+	}
+
+	CivilDate getCivilFromDays(std::int64_t days)
+	{
+		days += 719468;
+		const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+		const std::int64_t dayOfEra = days - era * 146097;
+		const std::int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+		const std::int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+		const std::int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+		const unsigned month = static_cast<unsigned>(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+		return CivilDate
+		{
+			.year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0),
+			.month = month,
+			.day = static_cast<unsigned>(dayOfYear - (153 * monthIndex + 2) / 5 + 1),
+		};
+	}
+
+	bool isLeapYear(std::int64_t year)
+	{
+		return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+	}
+
+	unsigned getDaysInMonth(std::int64_t year, unsigned month)
+	{
+		constexpr unsigned c_days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+		return month == 2 && isLeapYear(year) ? 29 : c_days[month - 1];
+	}
+
+	// YYYY-MM-DD; years outside 0000-9999 get a sign and as many digits as they need
+	char* writeDate(const CivilDate& date, char* dst)
+	{
+		if (date.year >= 0 && date.year <= 9999)
+		{
+			const unsigned year = static_cast<unsigned>(date.year);
+			dst = writeTwoDigits(year / 100, dst);
+			dst = writeTwoDigits(year % 100, dst);
+		}
+		else
+		{
+			*dst++ = date.year < 0 ? '-' : '+';
+			const std::uint64_t year = date.year < 0 ? std::uint64_t(0) - static_cast<std::uint64_t>(date.year) : static_cast<std::uint64_t>(date.year);
+			char digits[24];
+			const std::size_t size = static_cast<std::size_t>(std::to_chars(digits, digits + sizeof(digits), year).ptr - digits);
+			for (std::size_t i = size; i < 4; i++)
+				*dst++ = '0';
+			std::memcpy(dst, digits, size);
+			dst += size;
+		}
+		*dst++ = '-';
+		dst = writeTwoDigits(date.month, dst);
+		*dst++ = '-';
+		return writeTwoDigits(date.day, dst);
+	}
+
+	// Reads YYYY-MM-DD (or a signed year of 4 or more digits) from the front of rest
+	std::expected<CivilDate, ConvertError> readDate(std::string_view& rest)
+	{
+		const bool negative = consume(rest, '-');
+		const bool sign = negative || consume(rest, '+');
+
+		std::size_t yearDigits = 0;
+		while (yearDigits < rest.size() && isDigit(rest[yearDigits]))
+			yearDigits++;
+		if (yearDigits < 4 || (!sign && yearDigits > 4))
+			return std::unexpected(ConvertError::InvalidSyntax);
+		if (yearDigits > c_maxYearDigits)
+			return std::unexpected(ConvertError::OutOfRange);
+
+		std::int64_t year = 0;
+		for (std::size_t i = 0; i < yearDigits; i++)
+			year = year * 10 + (rest[i] - '0');
+		rest.remove_prefix(yearDigits);
+
+		unsigned month = 0;
+		unsigned day = 0;
+		if (!consume(rest, '-') || !readDigits(rest, 2, month) || !consume(rest, '-') || !readDigits(rest, 2, day))
+			return std::unexpected(ConvertError::InvalidSyntax);
+
+		const CivilDate date{ negative ? -year : year, month, day };
+		if (month < 1 || month > 12 || day < 1 || day > getDaysInMonth(date.year, month))
+			return std::unexpected(ConvertError::OutOfRange);
+		return date;
+	}
+
+	// Reads the digits after '.' or ',' as nanoseconds, if there is a fraction
+	std::expected<bool, ConvertError> readFraction(std::string_view& rest, std::int64_t& nanoseconds)
+	{
+		nanoseconds = 0;
+		if (!consume(rest, '.') && !consume(rest, ','))
+			return false;
+
+		std::size_t digits = 0;
+		std::int64_t scale = Converter::Impl::c_nanosPerSecond;
+		for (; digits < rest.size() && isDigit(rest[digits]); digits++)
+		{
+			scale /= 10;
+			// Digits past nanoseconds can't be represented unless they are zero
+			if (scale == 0 && rest[digits] != '0')
+				return std::unexpected(ConvertError::OutOfRange);
+			nanoseconds += (rest[digits] - '0') * scale;
+		}
+		if (digits == 0)
+			return std::unexpected(ConvertError::InvalidSyntax);
+		rest.remove_prefix(digits);
+		return true;
+	}
+
+	// Reads HH:MM:SS with an optional fraction; returns the seconds of the day
+	std::expected<std::int64_t, ConvertError> readTime(std::string_view& rest, std::int64_t& nanoseconds)
+	{
+		unsigned hours = 0;
+		unsigned minutes = 0;
+		unsigned seconds = 0;
+		if (!readDigits(rest, 2, hours) || !consume(rest, ':') || !readDigits(rest, 2, minutes) || !consume(rest, ':') || !readDigits(rest, 2, seconds))
+			return std::unexpected(ConvertError::InvalidSyntax);
+		// system_clock has no leap seconds, so 60 is out of range as well
+		if (hours > 23 || minutes > 59 || seconds > 59)
+			return std::unexpected(ConvertError::OutOfRange);
+
+		auto fraction = readFraction(rest, nanoseconds);
+		if (!fraction)
+			return std::unexpected(fraction.error());
+
+		return std::int64_t(hours) * 3600 + minutes * 60 + seconds;
+	}
+
+	// Z, or +HH:MM / -HH:MM; returns the offset from UTC in seconds
+	std::expected<std::int64_t, ConvertError> readZone(std::string_view& rest)
+	{
+		if (rest.empty() || consume(rest, 'Z') || consume(rest, 'z'))
+			return 0;
+
+		const bool negative = consume(rest, '-');
+		if (!negative && !consume(rest, '+'))
+			return std::unexpected(ConvertError::TrailingCharacters);
+
+		unsigned hours = 0;
+		unsigned minutes = 0;
+		if (!readDigits(rest, 2, hours) || !consume(rest, ':') || !readDigits(rest, 2, minutes))
+			return std::unexpected(ConvertError::InvalidSyntax);
+		if (hours > 23 || minutes > 59)
+			return std::unexpected(ConvertError::OutOfRange);
+
+		const std::int64_t offset = std::int64_t(hours) * 3600 + minutes * 60;
+		return negative ? -offset : offset;
+	}
+
+	char* writeUnsigned(std::uint64_t val, char* dst)
+	{
+		return std::to_chars(dst, dst + 20, val).ptr;
+	}
+
+	// Reads the digits of a duration component
+	std::expected<std::uint64_t, ConvertError> readComponentNumber(std::string_view& rest)
+	{
+		std::uint64_t value = 0;
+		auto [ptr, ec] = std::from_chars(rest.data(), rest.data() + rest.size(), value);
+		if (ec == std::errc::invalid_argument)
+			return std::unexpected(ConvertError::InvalidSyntax);
+		if (ec == std::errc::result_out_of_range)
+			return std::unexpected(ConvertError::OutOfRange);
+		rest.remove_prefix(static_cast<std::size_t>(ptr - rest.data()));
+		return value;
+	}
+}
+
+namespace Converter::Impl
+{
+	bool writeIsoDate(const std::chrono::year_month_day& date, OutputBuffer& out)
+	{
+		// Months and days up to 255 can be stored, but only two digits can be written
+		if (!date.ok())
+			return false;
+
+		char* dst = out.prepare(c_maxTextSize);
+		char* end = writeDate(CivilDate{ static_cast<int>(date.year()), static_cast<unsigned>(date.month()), static_cast<unsigned>(date.day()) }, dst);
+		out.commit(static_cast<std::size_t>(end - dst));
+		return true;
+	}
+
+	std::expected<std::chrono::year_month_day, ConvertError> readIsoDate(std::string_view str)
+	{
+		auto date = readDate(str);
+		if (!date)
+			return std::unexpected(date.error());
+		if (!str.empty())
+			return std::unexpected(ConvertError::TrailingCharacters);
+		if (date->year < static_cast<int>(std::chrono::year::min()) || date->year > static_cast<int>(std::chrono::year::max()))
+			return std::unexpected(ConvertError::OutOfRange);
+
+		return std::chrono::year_month_day{ std::chrono::year(static_cast<int>(date->year)), std::chrono::month(date->month), std::chrono::day(date->day) };
+	}
+
+	void writeIsoTimestamp(const IsoTimestamp& timestamp, int fractionDigits, OutputBuffer& out)
+	{
+		// Floor division so times before the epoch land on the previous day
+		std::int64_t days = timestamp.seconds / c_secondsPerDay;
+		std::int64_t secondsOfDay = timestamp.seconds % c_secondsPerDay;
+		if (secondsOfDay < 0)
+		{
+			days--;
+			secondsOfDay += c_secondsPerDay;
+		}
+
+		char* const start = out.prepare(c_maxTextSize);
+		char* dst = writeDate(getCivilFromDays(days), start);
+		*dst++ = 'T';
+		dst = writeTwoDigits(static_cast<unsigned>(secondsOfDay / 3600), dst);
+		*dst++ = ':';
+		dst = writeTwoDigits(static_cast<unsigned>(secondsOfDay / 60 % 60), dst);
+		*dst++ = ':';
+		dst = writeTwoDigits(static_cast<unsigned>(secondsOfDay % 60), dst);
+
+		if (fractionDigits > 0)
+		{
+			*dst++ = '.';
+			std::uint64_t fraction = static_cast<std::uint64_t>(timestamp.nanoseconds);
+			for (int i = 9; i > fractionDigits; i--)
+				fraction /= 10;
+			for (int i = fractionDigits - 1; i >= 0; i--)
+			{
+				dst[i] = static_cast<char>('0' + fraction % 10);
+				fraction /= 10;
+			}
+			dst += fractionDigits;
+		}
+		*dst++ = 'Z';
+		out.commit(static_cast<std::size_t>(dst - start));
+	}
+
+	std::expected<IsoTimestamp, ConvertError> readIsoTimestamp(std::string_view str)
+	{
+		auto date = readDate(str);
+		if (!date)
+			return std::unexpected(date.error());
+
+		const std::int64_t days = getDaysFromCivil(*date);
+		if (days > c_maxSeconds / c_secondsPerDay || days < c_minSeconds / c_secondsPerDay - 1)
+			return std::unexpected(ConvertError::OutOfRange);
+
+		// Midnight of the earliest day is out of range but later times of it aren't; count from the next midnight
+		const bool isFirstDay = days < c_minSeconds / c_secondsPerDay;
+		IsoTimestamp timestamp{ (isFirstDay ? days + 1 : days) * c_secondsPerDay, 0 };
+		// A date on its own is midnight UTC
+		if (str.empty())
+		{
+			if (isFirstDay)
+				return std::unexpected(ConvertError::OutOfRange);
+			return timestamp;
+		}
+
+		if (!consume(str, 'T') && !consume(str, 't') && !consume(str, ' '))
+			return std::unexpected(ConvertError::InvalidSyntax);
+
+		auto time = readTime(str, timestamp.nanoseconds);
+		if (!time)
+			return std::unexpected(time.error());
+
+		auto offset = readZone(str);
+		if (!offset)
+			return std::unexpected(offset.error());
+		if (!str.empty())
+			return std::unexpected(ConvertError::TrailingCharacters);
+
+		// Less than two days either way, but the date may be right at the limit
+		const std::int64_t delta = *time - *offset - (isFirstDay ? c_secondsPerDay : 0);
+		if ((delta > 0 && timestamp.seconds > c_maxSeconds - delta) || (delta < 0 && timestamp.seconds < c_minSeconds - delta))
+			return std::unexpected(ConvertError::OutOfRange);
+
+		timestamp.seconds += delta;
+		return timestamp;
+	}
+
+	void writeIsoDuration(const IsoDuration& duration, OutputBuffer& out)
+	{
+		char* const start = out.prepare(c_maxTextSize);
+		char* dst = start;
+		if (duration.negative)
+			*dst++ = '-';
+		*dst++ = 'P';
+
+		if (duration.weeks)
+		{
+			dst = writeUnsigned(duration.weeks, dst);
+			*dst++ = 'W';
+			out.commit(static_cast<std::size_t>(dst - start));
+			return;
+		}
+
+		if (duration.days)
+		{
+			dst = writeUnsigned(duration.days, dst);
+			*dst++ = 'D';
+		}
+
+		const bool zero = !duration.days && !duration.hours && !duration.minutes && !duration.seconds && !duration.nanoseconds;
+		if (duration.hours || duration.minutes || duration.seconds || duration.nanoseconds || zero)
+		{
+			*dst++ = 'T';
+			if (duration.hours)
+			{
+				dst = writeUnsigned(duration.hours, dst);
+				*dst++ = 'H';
+			}
+			if (duration.minutes)
+			{
+				dst = writeUnsigned(duration.minutes, dst);
+				*dst++ = 'M';
+			}
+			if (duration.seconds || duration.nanoseconds || zero)
+			{
+				dst = writeUnsigned(duration.seconds, dst);
+				if (duration.nanoseconds)
+				{
+					// Nine digits, then drop the trailing zeros
+					*dst++ = '.';
+					std::uint64_t fraction = duration.nanoseconds;
+					for (int i = 8; i >= 0; i--)
+					{
+						dst[i] = static_cast<char>('0' + fraction % 10);
+						fraction /= 10;
+					}
+					dst += 9;
+					while (dst[-1] == '0')
+						dst--;
+				}
+				*dst++ = 'S';
+			}
+		}
+		out.commit(static_cast<std::size_t>(dst - start));
+	}
+
+	std::expected<IsoDuration, ConvertError> readIsoDuration(std::string_view str)
+	{
+		IsoDuration duration;
+		duration.negative = consume(str, '-');
+		if (!consume(str, 'P') || str.empty())
+			return std::unexpected(ConvertError::InvalidSyntax);
+
+		// Components must come in this order, each at most once; only seconds may have a fraction
+		struct Component
+		{
+			char designator;
+			bool time;
+			std::uint64_t IsoDuration::* value;
+		};
+		constexpr Component c_components[] =
+		{
+			{ 'W', false, &IsoDuration::weeks },
+			{ 'D', false, &IsoDuration::days },
+			{ 'H', true, &IsoDuration::hours },
+			{ 'M', true, &IsoDuration::minutes },
+			{ 'S', true, &IsoDuration::seconds },
+		};
+
+		bool inTime = false;
+		std::size_t next = 0;
+		while (!str.empty())
+		{
+			if (!inTime && consume(str, 'T'))
+			{
+				inTime = true;
+				if (str.empty())
+					return std::unexpected(ConvertError::InvalidSyntax);
+				continue;
+			}
+
+			auto value = readComponentNumber(str);
+			if (!value)
+				return std::unexpected(value.error());
+
+			std::int64_t nanoseconds = 0;
+			auto fraction = readFraction(str, nanoseconds);
+			if (!fraction)
+				return std::unexpected(fraction.error());
+			if (str.empty())
+				return std::unexpected(ConvertError::InvalidSyntax);
+
+			const char designator = str.front();
+			while (next < std::size(c_components) && (c_components[next].designator != designator || c_components[next].time != inTime))
+				next++;
+			// Also rejects calendar months and years, which have no fixed length
+			if (next == std::size(c_components) || (*fraction && designator != 'S'))
+				return std::unexpected(ConvertError::InvalidSyntax);
+
+			duration.*c_components[next].value = *value;
+			duration.nanoseconds = static_cast<std::uint64_t>(nanoseconds);
+			str.remove_prefix(1);
+			next++;
+
+			// Weeks can't be combined with other components
+			if (designator == 'W' && !str.empty())
+				return std::unexpected(ConvertError::InvalidSyntax);
+		}
+
+		// At least one component
+		if (next == 0)
+			return std::unexpected(ConvertError::InvalidSyntax);
+		return duration;
+	}
+}
@@ -1,15 +1,255 @@
 #include <Converter/Converter.h>
+#include <Converter/ParallelConvert.h>
 
+#include "ConverterCounters.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <mutex>
+#include <stdexcept>
 
 
 namespace
 {
-	// Delay the initialization of converters until the initialize function is called
-	std::mutex g_delayConvertersMutex;
-	std::vector<Converter::ConverterInfo> g_delayConverters;
-	std::vector<Converter::ConverterInfo> g_converters;
-	bool g_convertersRegistered = false;
+	// Open addressing (linear probing) hash index of the registered converters
+	// Readers never lock: finding a converter is one atomic load of the current table followed by
+	// atomic loads of the probed slots. Writers are serialized by g_registryMutex and publish a new
+	// converter by storing it into an empty slot. When the load factor would pass 50% the writer copies
+	// the index into a table twice the size and publishes that table instead. Replaced tables stay
+	// alive as a reader may still be probing them; as the tables double they never add up to more
+	// than the current one.
+	template <typename Key, Key (*GetKey)(const Converter::ConverterInfo&)>
+	class ConcurrentIndex
+	{
+	public:
+		const Converter::ConverterInfo* find(const Key& key) const
+		{
+			const Table* table = m_table.load(std::memory_order_acquire);
+			if (!table)
+				return nullptr;
+
+			for (std::size_t slot = std::hash<Key>{}(key) & table->mask; ; slot = (slot + 1) & table->mask)
+			{
+				const Converter::ConverterInfo* info = table->slots[slot].load(std::memory_order_acquire);
+				if (!info)
+					return nullptr;
+				if (GetKey(*info) == key)
+					return info;
+			}
+		}
+
+		// Requires g_registryMutex; info must stay valid for the lifetime of the program
+		void insert(const Converter::ConverterInfo* info)
+		{
+			const Table* table = m_table.load(std::memory_order_relaxed);
+			if (!table || (m_count + 1) * 2 > table->mask + 1)
+				table = grow(table);
+
+			insertInto(*table, info);
+			m_count++;
+		}
+
+	private:
+		struct Table
+		{
+			explicit Table(std::size_t capacity)
+				: mask(capacity - 1)
+				, slots(std::make_unique<std::atomic<const Converter::ConverterInfo*>[]>(capacity))
+			{
+			}
+
+			std::size_t mask;
+			std::unique_ptr<std::atomic<const Converter::ConverterInfo*>[]> slots;
+		};
+
+		static void insertInto(const Table& table, const Converter::ConverterInfo* info)
+		{
+			std::size_t slot = std::hash<Key>{}(GetKey(*info)) & table.mask;
+			while (table.slots[slot].load(std::memory_order_relaxed))
+				slot = (slot + 1) & table.mask;
+
+			table.slots[slot].store(info, std::memory_order_release);
+		}
+
+		const Table* grow(const Table* old)
+		{
+			auto table = std::make_unique<Table>(old ? (old->mask + 1) * 2 : 8);
+			if (old)
+			{
+				for (std::size_t slot = 0; slot <= old->mask; slot++)
+				{
+					if (const auto* info = old->slots[slot].load(std::memory_order_relaxed))
+						insertInto(*table, info);
+				}
+			}
+
+			m_table.store(table.get(), std::memory_order_release);
+			m_tables.push_back(std::move(table));
+			return m_tables.back().get();
+		}
+
+		std::atomic<const Table*> m_table = nullptr;
+		// Every table ever published, see above
+		std::vector<std::unique_ptr<Table>> m_tables;
+		std::size_t m_count = 0;
+	};
+
+	std::type_index getConverterIndex(const Converter::ConverterInfo& info) { return info.getIndex(); }
+	std::string_view getConverterName(const Converter::ConverterInfo& info) { return info.name; }
+
+	// The built-in converters are built at compile time, so they exist before any code runs
+	constexpr Converter::ConverterInfo c_builtinConverters[] =
+	{
+		Converter::Impl::makeTraitsConverterInfo<int>("int"),
+		Converter::Impl::makeTraitsConverterInfo<float>("float"),
+		Converter::Impl::makeTraitsConverterInfo<double>("double"),
+		Converter::Impl::makeTraitsConverterInfo<bool>("bool"),
+		Converter::Impl::makeTraitsConverterInfo<std::string>("std::string"),
+		Converter::Impl::makeTraitsConverterInfo<char>("char"),
+		Converter::Impl::makeTraitsConverterInfo<signed char>("signed char"),
+		Converter::Impl::makeTraitsConverterInfo<short>("short"),
+		Converter::Impl::makeTraitsConverterInfo<long>("long"),
+		Converter::Impl::makeTraitsConverterInfo<long long>("long long"),
+		Converter::Impl::makeTraitsConverterInfo<unsigned char>("unsigned char"),
+		Converter::Impl::makeTraitsConverterInfo<unsigned short>("unsigned short"),
+		Converter::Impl::makeTraitsConverterInfo<unsigned int>("unsigned int"),
+		Converter::Impl::makeTraitsConverterInfo<unsigned long>("unsigned long"),
+		Converter::Impl::makeTraitsConverterInfo<unsigned long long>("unsigned long long"),
+		Converter::Impl::makeTraitsConverterInfo<long double>("long double"),
+		Converter::Impl::makeTraitsConverterInfo<Log::Color>("Log::Color"),
+		Converter::Impl::makeTraitsConverterInfo<Log::Level>("Log::Level"),
+
+		// Common composites; any other combination can be registered with REGISTER_TRAITS_CONVERTER (see CompositeTraits.h)
+		Converter::Impl::makeTraitsConverterInfo<std::vector<int>>("std::vector<int>"),
+		Converter::Impl::makeTraitsConverterInfo<std::vector<float>>("std::vector<float>"),
+		Converter::Impl::makeTraitsConverterInfo<std::vector<double>>("std::vector<double>"),
+		Converter::Impl::makeTraitsConverterInfo<std::vector<std::string>>("std::vector<std::string>"),
+
+		// Byte buffers (see ByteEncoding.h); fixed size arrays can be registered with REGISTER_TRAITS_CONVERTER
+		Converter::Impl::makeTraitsConverterInfo<std::vector<std::byte>>("std::vector<std::byte>"),
+		Converter::Impl::makeTraitsConverterInfo<Converter::Base64<std::vector<std::byte>>>("Converter::Base64<std::vector<std::byte>>"),
+		Converter::Impl::makeTraitsConverterInfo<Converter::Hex<std::vector<std::uint8_t>>>("Converter::Hex<std::vector<std::uint8_t>>"),
+		Converter::Impl::makeTraitsConverterInfo<Converter::Base64<std::vector<std::uint8_t>>>("Converter::Base64<std::vector<std::uint8_t>>"),
+
+		// ISO-8601 dates, times and durations (see ChronoTraits.h)
+		Converter::Impl::makeTraitsConverterInfo<std::chrono::system_clock::time_point>("std::chrono::system_clock::time_point"),
+		Converter::Impl::makeTraitsConverterInfo<std::chrono::year_month_day>("std::chrono::year_month_day"),
+		Converter::Impl::makeTraitsConverterInfo<std::chrono::nanoseconds>("std::chrono::nanoseconds"),
+		Converter::Impl::makeTraitsConverterInfo<std::chrono::microseconds>("std::chrono::microseconds"),
+		Converter::Impl::makeTraitsConverterInfo<std::chrono::milliseconds>("std::chrono::milliseconds"),
+		Converter::Impl::makeTraitsConverterInfo<std::chrono::seconds>("std::chrono::seconds"),
+		Converter::Impl::makeTraitsConverterInfo<std::chrono::minutes>("std::chrono::minutes"),
+		Converter::Impl::makeTraitsConverterInfo<std::chrono::hours>("std::chrono::hours"),
+		Converter::Impl::makeTraitsConverterInfo<std::chrono::days>("std::chrono::days"),
+	};
+
+	constexpr std::size_t c_builtinCount = std::size(c_builtinConverters);
+
+	// The fixed width integer types can also be found by name
+	// Each is an alias of one of the standard integer types above, and which one depends on the platform
+	struct BuiltinAlias
+	{
+		std::string_view name;
+		const std::type_info* type;
+	};
+
+	constexpr BuiltinAlias c_builtinAliases[] =
+	{
+		{ "std::int8_t", &typeid(std::int8_t) },
+		{ "std::int16_t", &typeid(std::int16_t) },
+		{ "std::int32_t", &typeid(std::int32_t) },
+		{ "std::int64_t", &typeid(std::int64_t) },
+		{ "std::uint8_t", &typeid(std::uint8_t) },
+		{ "std::uint16_t", &typeid(std::uint16_t) },
+		{ "std::uint32_t", &typeid(std::uint32_t) },
+		{ "std::uint64_t", &typeid(std::uint64_t) },
+	};
+
+	// The built-in converters sorted by name
+	constexpr std::array<const Converter::ConverterInfo*, c_builtinCount> c_builtinsByName = []()
+		{
+			std::array<const Converter::ConverterInfo*, c_builtinCount> sorted{};
+			for (std::size_t i = 0; i < c_builtinCount; i++)
+				sorted[i] = &c_builtinConverters[i];
+			std::sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) { return a->name < b->name; });
+			return sorted;
+		}();
+
+	// Lookups used until initializeConverters adds the built-in converters to the hash indexes
+	const Converter::ConverterInfo* findBuiltinConverter(const std::type_index& index)
+	{
+		for (const auto& info : c_builtinConverters)
+		{
+			if (info.getIndex() == index)
+				return &info;
+		}
+		return nullptr;
+	}
+
+	const Converter::ConverterInfo* findBuiltinConverter(std::string_view name)
+	{
+		auto it = std::lower_bound(c_builtinsByName.begin(), c_builtinsByName.end(), name, [](const auto* info, std::string_view key) { return info->name < key; });
+		if (it != c_builtinsByName.end() && (*it)->name == name)
+			return *it;
+
+		for (const auto& alias : c_builtinAliases)
+		{
+			if (alias.name == name)
+				return findBuiltinConverter(std::type_index(*alias.type));
+		}
+		return nullptr;
+	}
+
+	// Converters registered before initializeConverters wait in g_delayConverters since registering logs;
+	// afterwards addConverter registers them immediately
+	// Everything here but the deques is constant initialized, so REGISTER_ macros may run during static initialization
+	struct DelayedConverter
+	{
+		Converter::ConverterInfo info;
+		std::string name;
+	};
+
+	std::mutex g_registryMutex;
+	std::vector<DelayedConverter> g_delayConverters;
+	// Registered converters and their names; deques so that the pointers handed out by the indexes stay valid
+	std::deque<Converter::ConverterInfo> g_converters;
+	std::deque<std::string> g_converterNames;
+	// Copies of the built-in converters under their alias names; only in the name index
+	std::deque<Converter::ConverterInfo> g_aliasConverters;
+	ConcurrentIndex<std::type_index, &getConverterIndex> g_convertersByIndex;
+	ConcurrentIndex<std::string_view, &getConverterName> g_convertersByName;
+#ifdef CONVERTER_STATS
+	// Counters of the built-in converters by position in c_builtinConverters, and of the registered ones
+	Converter::Impl::ConverterCounters g_builtinCounters[c_builtinCount];
+	std::deque<Converter::Impl::ConverterCounters> g_converterCounters;
+#endif
+	// Set once the built-in converters are in the indexes and converters are registered immediately
+	std::atomic<bool> g_convertersRegistered = false;
+	bool g_logRegistrations = false;
+
+	// Requires g_registryMutex
+	void registerConverterLocked(const Converter::ConverterInfo& info, std::string_view name)
+	{
+		if (g_convertersByIndex.find(info.getIndex()) || findBuiltinConverter(info.getIndex()))
+		{
+			// Should not happen as uniqueness is compile time enforced unless namespace shennanigains are used
+			Log::Warn().log("Converter already registered for type: {}", name);
+			return;
+		}
+
+		Converter::ConverterInfo& registered = g_converters.emplace_back(info);
+		registered.name = g_converterNames.emplace_back(name);
+#ifdef CONVERTER_STATS
+		registered.counters = &g_converterCounters.emplace_back();
+#endif
+		g_convertersByIndex.insert(&registered);
+		g_convertersByName.insert(&registered);
+		if (g_logRegistrations)
+			Log::Info().log("Successfully registered converter for type: {}", name);
+	}
 }
 
 namespace Converter
@@ -19,23 +259,52 @@ namespace Converter
 	{
 		void addConverter(const ConverterInfo& info)
 		{
-			std::lock_guard<std::mutex> lock(g_delayConvertersMutex);
-			g_delayConverters.push_back(info);
+			std::lock_guard<std::mutex> lock(g_registryMutex);
+			if (g_convertersRegistered.load(std::memory_order_relaxed))
+				registerConverterLocked(info, info.name);
+			else
+				g_delayConverters.push_back(DelayedConverter{ info, std::string(info.name) });
 		}
 
-		const std::vector<ConverterInfo>& getRegisteredConverters()
+		std::vector<const ConverterInfo*> getRegisteredConverters()
 		{
-			return g_converters;
+			std::lock_guard<std::mutex> lock(g_registryMutex);
+			std::vector<const ConverterInfo*> converters;
+			converters.reserve(c_builtinCount + g_converters.size());
+			for (const auto& converter : c_builtinConverters)
+				converters.push_back(&converter);
+			for (const auto& converter : g_converters)
+				converters.push_back(&converter);
+			return converters;
 		}
 
+#ifdef CONVERTER_STATS
+		ConverterCounters* getCounters(const ConverterInfo& converter)
+		{
+			if (converter.counters)
+				return converter.counters;
+
+			// Converters that weren't registered, e.g. copies, aren't counted
+			const std::less<const ConverterInfo*> less;
+			if (less(&converter, std::begin(c_builtinConverters)) || !less(&converter, std::end(c_builtinConverters)))
+				return nullptr;
+
+			return &g_builtinCounters[&converter - std::begin(c_builtinConverters)];
+		}
+#endif
+
 		std::string getStrUsingConverter(const ConverterInfo& converter, const std::any& val)
 		{
+			StatsScope stats(converter, StatsCall::ToString);
 			try
 			{
-				return converter.toStr(val);
+				std::string str = converter.toStr(val);
+				stats.addProduced(str.size());
+				return str;
 			}
 			catch (const std::bad_any_cast& e)
 			{
+				stats.addFailure();
 				Log::Error().log("Unable to convert type to string; toStr failed! Attempted to use converter with name: {}", converter.name);
 				assert(false && "Caught bad any cast!");
 			}
@@ -45,57 +314,198 @@ namespace Converter
 
 		std::any getAnyUsingConverter(const ConverterInfo& converter, const std::string& val)
 		{
+			StatsScope stats(converter, StatsCall::FromString);
+			stats.addConsumed(val.size());
 			try
 			{
 				return converter.fromStr(val);
 			}
 			catch (const std::bad_any_cast& e)
 			{
+				stats.addFailure();
 				Log::Error().log("Unable to convert string to type; fromStr failed! Attempted to use converter with name: {}", converter.name);
 				assert(false && "Caught bad any cast!");
 			}
+			catch (const std::exception&)
+			{
+				// Legacy converters report bad input by throwing
+				stats.addFailure();
+				throw;
+			}
 
 			return std::any();
 		}
 
-		const ConverterInfo* findConverter(const std::string& name)
+		void appendStrUsingConverter(const ConverterInfo& converter, const std::any& val, OutputBuffer& out)
 		{
-			auto findConverter = std::find_if(Impl::getRegisteredConverters().begin(), Impl::getRegisteredConverters().end(),
-				[&name](const ConverterInfo& comp) { return name == comp.name; }
-			);
-			if (findConverter == Impl::getRegisteredConverters().end())
+			if (!converter.toChars)
 			{
-				Log::Error().log("Unable to convert from string! Converter not found! Name: {}!", name);
+				out.append(getStrUsingConverter(converter, val));
+				return;
 			}
-			else
+
+			StatsScope stats(converter, StatsCall::ToString);
+			const std::size_t start = out.size();
+			try
+			{
+				converter.toChars(val, out);
+				stats.addProduced(out.size() - start);
+			}
+			catch (const std::bad_any_cast& e)
+			{
+				stats.addFailure();
+				Log::Error().log("Unable to convert type to string; toChars failed! Attempted to use converter with name: {}", converter.name);
+				assert(false && "Caught bad any cast!");
+			}
+		}
+
+		void appendStrUsingConverter(const ConverterInfo& converter, const std::any& val, const FormatSpec& spec, OutputBuffer& out)
+		{
+			if (!converter.toFormattedChars || spec.isDefault())
 			{
-				return &(*findConverter);
+				const std::size_t start = out.size();
+				appendStrUsingConverter(converter, val, out);
+				if (!spec.isDefault())
+					alignFormatted(spec, out, start);
+				return;
 			}
 
-			return nullptr;
+			StatsScope stats(converter, StatsCall::ToString);
+			const std::size_t start = out.size();
+			try
+			{
+				converter.toFormattedChars(val, spec, out);
+				stats.addProduced(out.size() - start);
+			}
+			catch (const std::bad_any_cast& e)
+			{
+				stats.addFailure();
+				Log::Error().log("Unable to convert type to string; toFormattedChars failed! Attempted to use converter with name: {}", converter.name);
+				assert(false && "Caught bad any cast!");
+			}
 		}
 
-		const ConverterInfo* findConverter(const std::type_index& index)
+		std::any getAnyUsingConverter(const ConverterInfo& converter, std::string_view val)
 		{
-			auto findConverter = std::find_if(Impl::getRegisteredConverters().begin(), Impl::getRegisteredConverters().end(),
-				[&index](const ConverterInfo& comp) { return index == comp.index; }
-			);
-			if (findConverter == Impl::getRegisteredConverters().end())
+			if (!converter.fromChars)
+				return getAnyUsingConverter(converter, std::string(val));
+
+			StatsScope stats(converter, StatsCall::FromString);
+			stats.addConsumed(val.size());
+			try
 			{
-				Log::Error().log("Unable to convert from string! Converter not found! Name: {}!", index.name());
+				return converter.fromChars(val);
 			}
-			else
+			catch (const std::exception&)
 			{
-				return &(*findConverter);
+				// Legacy converters report bad input by throwing
+				stats.addFailure();
+				throw;
 			}
+		}
+
+		std::expected<std::any, ConvertError> tryGetAnyUsingConverter(const ConverterInfo& converter, std::string_view val)
+		{
+			StatsScope stats(converter, StatsCall::FromString);
+			stats.addConsumed(val.size());
+			auto result = [&]() -> std::expected<std::any, ConvertError>
+				{
+					if (converter.tryFromChars)
+						return converter.tryFromChars(val);
 
-			return nullptr;
+					// Legacy converters can only report errors by throwing
+					try
+					{
+						return converter.fromStr(std::string(val));
+					}
+					catch (const std::invalid_argument&)
+					{
+						return std::unexpected(ConvertError::InvalidSyntax);
+					}
+					catch (const std::out_of_range&)
+					{
+						return std::unexpected(ConvertError::OutOfRange);
+					}
+					catch (const std::exception&)
+					{
+						return std::unexpected(ConvertError::InvalidSyntax);
+					}
+				}();
+
+			if (!result)
+				stats.addFailure();
+			return result;
+		}
+
+		bool encodeUsingConverter(const ConverterInfo& converter, const std::any& val, ByteWriter& out)
+		{
+			if (!converter.encode)
+			{
+				Log::Error().log("Converter has no binary form! Name: {}!", converter.name);
+				return false;
+			}
+
+			StatsScope stats(converter, StatsCall::Encode);
+			const std::size_t start = out.size();
+			try
+			{
+				converter.encode(val, out);
+				stats.addProduced(out.size() - start);
+				return true;
+			}
+			catch (const std::bad_any_cast& e)
+			{
+				stats.addFailure();
+				Log::Error().log("Unable to convert type to bytes; encode failed! Attempted to use converter with name: {}", converter.name);
+				assert(false && "Caught bad any cast!");
+			}
+
+			return false;
+		}
+
+		std::expected<std::any, ConvertError> decodeUsingConverter(const ConverterInfo& converter, ByteReader& in)
+		{
+			if (!converter.decode)
+				return std::unexpected(ConvertError::NoConverter);
+
+			StatsScope stats(converter, StatsCall::Decode);
+			const std::size_t remaining = in.remaining();
+			auto result = converter.decode(in);
+			stats.addConsumed(remaining - in.remaining());
+			if (!result)
+				stats.addFailure();
+			return result;
+		}
+
+		// The flag is read before the index: once it is set every built-in converter is in the index
+		const ConverterInfo* findConverter(std::string_view name, bool logMissing)
+		{
+			const bool indexed = g_convertersRegistered.load(std::memory_order_acquire);
+			const ConverterInfo* converter = g_convertersByName.find(name);
+			if (!converter && !indexed)
+				converter = findBuiltinConverter(name);
+			if (!converter && logMissing)
+				Log::Error().log("Converter not found! Name: {}!", name);
+
+			return converter;
+		}
+
+		const ConverterInfo* findConverter(const std::type_index& index, bool logMissing)
+		{
+			const bool indexed = g_convertersRegistered.load(std::memory_order_acquire);
+			const ConverterInfo* converter = g_convertersByIndex.find(index);
+			if (!converter && !indexed)
+				converter = findBuiltinConverter(index);
+			if (!converter && logMissing)
+				Log::Error().log("Converter not found! Name: {}!", index.name());
+
+			return converter;
 		}
 	}
 
 	std::string getStringFromAny(const std::type_index& index, const std::any val)
 	{
-		if (auto* converter = Impl::findConverter(index))
+		if (auto* converter = Impl::findConverter(index, true))
 			return Impl::getStrUsingConverter(*converter, val);
 
 		return "";
@@ -103,62 +513,195 @@ namespace Converter
 
 	std::string getStringFromAny(const std::string& name, const std::any val)
 	{
-		if (auto* converter = Impl::findConverter(name))
+		if (auto* converter = Impl::findConverter(name, true))
 			return Impl::getStrUsingConverter(*converter, val);
 
 		return "";
 	}
 
-	void initializeConverters()
-	{
-		REGISTER_CONVERTER(
-			int, 
-			[](const int& i) { return std::to_string(i); },
-			[](const std::string& str) { return std::stoi(str); }
-		)
-		REGISTER_CONVERTER(
-			float, 
-			[](const float& f) { return std::to_string(f); },
-			[](const std::string& str) { return std::stof(str); }
-		)
-		REGISTER_CONVERTER(
-			double, 
-			[](const double& d) { return std::to_string(d); },
-			[](const std::string& str) { return std::stod(str); }
-		)
-		REGISTER_CONVERTER(
-			bool, 
-			[](const bool& b) { return std::to_string(b); },
-			[](const std::string& str) { return static_cast<bool>(std::stoi(str)); }
-		)
-		REGISTER_CONVERTER(
-			std::string, 
-			[](const std::string& str) { return str; },
-			[](const std::string& str) { return str; }
-		)
-
-		if (g_convertersRegistered)
+	bool getStringFromAny(const std::type_index& index, const std::any& val, OutputBuffer& out)
+	{
+		if (auto* converter = Impl::findConverter(index, true))
 		{
-			Log::Warn().log("initializeConverters has already been called!");
-			return;
+			Impl::appendStrUsingConverter(*converter, val, out);
+			return true;
 		}
-		for (const auto& delayConverter : g_delayConverters)
+
+		return false;
+	}
+
+	bool getStringFromAny(std::string_view name, const std::any& val, OutputBuffer& out)
+	{
+		if (auto* converter = Impl::findConverter(name, true))
 		{
-			auto findConverter = std::find_if(g_converters.begin(), g_converters.end(),
-				[&delayConverter](const ConverterInfo& comp) { return delayConverter.index == comp.index; }
-			);
-			if (findConverter == g_converters.end())
-			{
-				g_converters.push_back(delayConverter);
-				Log::Info().log("Successfully registered converter for type: {}", delayConverter.name);
-			}
-			else
+			Impl::appendStrUsingConverter(*converter, val, out);
+			return true;
+		}
+
+		return false;
+	}
+
+	std::string getStringFromAny(const std::type_index& index, const std::any& val, const FormatSpec& spec)
+	{
+		OutputBuffer out;
+		getStringFromAny(index, val, spec, out);
+		return out.str();
+	}
+
+	std::string getStringFromAny(std::string_view name, const std::any& val, const FormatSpec& spec)
+	{
+		OutputBuffer out;
+		getStringFromAny(name, val, spec, out);
+		return out.str();
+	}
+
+	bool getStringFromAny(const std::type_index& index, const std::any& val, const FormatSpec& spec, OutputBuffer& out)
+	{
+		if (auto* converter = Impl::findConverter(index, true))
+		{
+			Impl::appendStrUsingConverter(*converter, val, spec, out);
+			return true;
+		}
+
+		return false;
+	}
+
+	bool getStringFromAny(std::string_view name, const std::any& val, const FormatSpec& spec, OutputBuffer& out)
+	{
+		if (auto* converter = Impl::findConverter(name, true))
+		{
+			Impl::appendStrUsingConverter(*converter, val, spec, out);
+			return true;
+		}
+
+		return false;
+	}
+
+	std::any getAnyFromString(const std::type_index& index, std::string_view str)
+	{
+		if (auto* converter = Impl::findConverter(index, true))
+			return Impl::getAnyUsingConverter(*converter, str);
+
+		return std::any();
+	}
+
+	std::any getAnyFromString(std::string_view name, std::string_view str)
+	{
+		if (auto* converter = Impl::findConverter(name, true))
+			return Impl::getAnyUsingConverter(*converter, str);
+
+		return std::any();
+	}
+
+	std::expected<std::any, ConvertError> tryGetAnyFromString(const std::type_index& index, std::string_view str)
+	{
+		if (auto* converter = Impl::findConverter(index))
+			return Impl::tryGetAnyUsingConverter(*converter, str);
+
+		return std::unexpected(ConvertError::NoConverter);
+	}
+
+	std::expected<std::any, ConvertError> tryGetAnyFromString(std::string_view name, std::string_view str)
+	{
+		if (auto* converter = Impl::findConverter(name))
+			return Impl::tryGetAnyUsingConverter(*converter, str);
+
+		return std::unexpected(ConvertError::NoConverter);
+	}
+
+	std::vector<std::byte> getBytesFromAny(const std::type_index& index, const std::any& val)
+	{
+		ByteWriter out;
+		getBytesFromAny(index, val, out);
+		return out.vector();
+	}
+
+	std::vector<std::byte> getBytesFromAny(std::string_view name, const std::any& val)
+	{
+		ByteWriter out;
+		getBytesFromAny(name, val, out);
+		return out.vector();
+	}
+
+	bool getBytesFromAny(const std::type_index& index, const std::any& val, ByteWriter& out)
+	{
+		if (auto* converter = Impl::findConverter(index, true))
+			return Impl::encodeUsingConverter(*converter, val, out);
+
+		return false;
+	}
+
+	bool getBytesFromAny(std::string_view name, const std::any& val, ByteWriter& out)
+	{
+		if (auto* converter = Impl::findConverter(name, true))
+			return Impl::encodeUsingConverter(*converter, val, out);
+
+		return false;
+	}
+
+	namespace
+	{
+		std::any decodeOrLogError(const ConverterInfo* converter, ByteReader& in)
+		{
+			if (!converter)
+				return std::any();
+
+			auto result = Impl::decodeUsingConverter(*converter, in);
+			if (!result)
 			{
-				// Should not happen as uniqueness is compile time enforced unless namespace shennanigains are used
-				Log::Warn().log("Converter already registered for type: {}", delayConverter.name);
+				Log::Error().log("Unable to convert bytes to type! Reason: {}! Attempted to use converter with name: {}", getStringForError(result.error()), converter->name);
+				return std::any();
 			}
+
+			return std::move(*result);
+		}
+	}
+
+	std::any getAnyFromBytes(const std::type_index& index, ByteReader& in)
+	{
+		return decodeOrLogError(Impl::findConverter(index, true), in);
+	}
+
+	std::any getAnyFromBytes(std::string_view name, ByteReader& in)
+	{
+		return decodeOrLogError(Impl::findConverter(name, true), in);
+	}
+
+	void initializeConverters(const ConverterInitOptions& opts)
+	{
+		std::lock_guard<std::mutex> lock(g_registryMutex);
+		if (g_convertersRegistered.load(std::memory_order_relaxed))
+		{
+			Log::Warn().log("initializeConverters has already been called!");
+			return;
 		}
 
-		g_convertersRegistered = true;
+		g_logRegistrations = opts.logRegistrations;
+		Impl::setParallelThreadCount(opts.parallelThreads);
+		for (const auto& converter : c_builtinConverters)
+		{
+			g_convertersByIndex.insert(&converter);
+			g_convertersByName.insert(&converter);
+			if (g_logRegistrations)
+				Log::Info().log("Successfully registered converter for type: {}", converter.name);
+		}
+
+		for (const auto& alias : c_builtinAliases)
+		{
+			const Converter::ConverterInfo* converter = findBuiltinConverter(std::type_index(*alias.type));
+			Converter::ConverterInfo& aliasConverter = g_aliasConverters.emplace_back(*converter);
+			aliasConverter.name = alias.name;
+#ifdef CONVERTER_STATS
+			// Counted together with the converter it is an alias of
+			aliasConverter.counters = Impl::getCounters(*converter);
+#endif
+			g_convertersByName.insert(&aliasConverter);
+		}
+
+		for (const auto& delayConverter : g_delayConverters)
+			registerConverterLocked(delayConverter.info, delayConverter.name);
+		g_delayConverters.clear();
+
+		g_convertersRegistered.store(true, std::memory_order_release);
 	}
 }
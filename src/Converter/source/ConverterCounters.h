@@ -0,0 +1,121 @@
+#pragma once
+
+#include <Converter/Converter.h>
+#include <Converter/ConverterStats.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Converter::Impl
+{
+	enum class StatsCall
+	{
+		ToString,
+		FromString,
+		Encode,
+		Decode,
+	};
+
+#ifdef CONVERTER_STATS
+	inline constexpr std::size_t c_statsShards = 8;
+
+	// The counters of one converter written by the threads of one shard
+	// A cache line of its own, so threads in other shards never invalidate it
+	struct alignas(64) CounterShard
+	{
+		std::array<std::atomic<std::uint64_t>, 4> calls{};
+		std::atomic<std::uint64_t> bytesProduced = 0;
+		std::atomic<std::uint64_t> bytesConsumed = 0;
+		std::atomic<std::uint64_t> failures = 0;
+		std::array<std::atomic<std::uint64_t>, c_latencyBuckets> latency{};
+	};
+
+	struct ConverterCounters
+	{
+		std::array<CounterShard, c_statsShards> shards;
+	};
+
+	// The counters of a converter from the registry, or nullptr for any other ConverterInfo
+	ConverterCounters* getCounters(const ConverterInfo& converter);
+
+	struct StatsThread
+	{
+		std::size_t shard;   // Assigned round robin on the thread's first call
+		std::uint32_t calls; // Calls counted on this thread, to pick the ones to time
+	};
+
+	// The stats state of the calling thread
+	StatsThread& getStatsThread();
+
+	// Counts one call of a converter for as long as it is in scope
+	class StatsScope
+	{
+	public:
+		StatsScope(const ConverterInfo& converter, StatsCall call)
+			: m_shard(nullptr)
+		{
+			ConverterCounters* counters = getCounters(converter);
+			if (!counters)
+				return;
+
+			StatsThread& thread = getStatsThread();
+			m_shard = &counters->shards[thread.shard];
+			m_shard->calls[static_cast<std::size_t>(call)].fetch_add(1, std::memory_order_relaxed);
+			if (++thread.calls % c_latencySampleRate == 0)
+				m_start = std::chrono::steady_clock::now();
+		}
+
+		~StatsScope()
+		{
+			if (!m_shard || m_start == std::chrono::steady_clock::time_point())
+				return;
+
+			const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+			const auto nanoseconds = static_cast<std::uint64_t>(std::max<std::int64_t>(elapsed, 1));
+			const std::size_t bucket = std::min<std::size_t>(std::bit_width(nanoseconds) - 1, c_latencyBuckets - 1);
+			m_shard->latency[bucket].fetch_add(1, std::memory_order_relaxed);
+		}
+
+		StatsScope(const StatsScope&) = delete;
+		StatsScope& operator=(const StatsScope&) = delete;
+
+		void addProduced(std::size_t bytes)
+		{
+			if (m_shard)
+				m_shard->bytesProduced.fetch_add(bytes, std::memory_order_relaxed);
+		}
+
+		void addConsumed(std::size_t bytes)
+		{
+			if (m_shard)
+				m_shard->bytesConsumed.fetch_add(bytes, std::memory_order_relaxed);
+		}
+
+		void addFailure()
+		{
+			if (m_shard)
+				m_shard->failures.fetch_add(1, std::memory_order_relaxed);
+		}
+
+	private:
+		CounterShard* m_shard;
+		std::chrono::steady_clock::time_point m_start;
+	};
+#else
+	// Stats are compiled out; every call is empty and optimized away
+	class StatsScope
+	{
+	public:
+		StatsScope(const ConverterInfo&, StatsCall) {}
+
+		void addProduced(std::size_t) {}
+		void addConsumed(std::size_t) {}
+		void addFailure() {}
+	};
+#endif
+}
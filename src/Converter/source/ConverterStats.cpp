@@ -0,0 +1,138 @@
+#include <Converter/ConverterStats.h>
+
+#include <Logger/Logger.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+
+#include "ConverterCounters.h"
+
+namespace
+{
+#ifdef CONVERTER_STATS
+	std::atomic<std::size_t> g_nextShard = 0;
+
+	std::uint64_t load(const std::atomic<std::uint64_t>& counter)
+	{
+		return counter.load(std::memory_order_relaxed);
+	}
+#endif
+}
+
+namespace Converter
+{
+#ifdef CONVERTER_STATS
+	namespace Impl
+	{
+		StatsThread& getStatsThread()
+		{
+			thread_local StatsThread thread{ g_nextShard.fetch_add(1, std::memory_order_relaxed) % c_statsShards, 0 };
+			return thread;
+		}
+	}
+#endif
+
+	std::uint64_t ConverterStats::getLatencySamples() const
+	{
+		std::uint64_t samples = 0;
+		for (std::uint64_t count : latency)
+			samples += count;
+		return samples;
+	}
+
+	std::uint64_t ConverterStats::getLatencyPercentile(double fraction) const
+	{
+		const std::uint64_t samples = getLatencySamples();
+		if (samples == 0)
+			return 0;
+
+		const std::uint64_t wanted = std::max<std::uint64_t>(static_cast<std::uint64_t>(std::ceil(fraction * static_cast<double>(samples))), 1);
+		std::uint64_t seen = 0;
+		for (std::size_t bucket = 0; bucket < c_latencyBuckets; bucket++)
+		{
+			seen += latency[bucket];
+			if (seen >= wanted)
+				return std::uint64_t(1) << (bucket + 1);
+		}
+		return std::uint64_t(1) << c_latencyBuckets;
+	}
+
+	std::vector<ConverterStats> getConverterStats()
+	{
+		std::vector<ConverterStats> stats;
+#ifdef CONVERTER_STATS
+		for (const ConverterInfo* converter : Impl::getRegisteredConverters())
+		{
+			const Impl::ConverterCounters* counters = Impl::getCounters(*converter);
+			if (!counters)
+				continue;
+
+			ConverterStats total{ .name = converter->name };
+			for (const auto& shard : counters->shards)
+			{
+				total.toStringCalls += load(shard.calls[static_cast<std::size_t>(Impl::StatsCall::ToString)]);
+				total.fromStringCalls += load(shard.calls[static_cast<std::size_t>(Impl::StatsCall::FromString)]);
+				total.encodeCalls += load(shard.calls[static_cast<std::size_t>(Impl::StatsCall::Encode)]);
+				total.decodeCalls += load(shard.calls[static_cast<std::size_t>(Impl::StatsCall::Decode)]);
+				total.bytesProduced += load(shard.bytesProduced);
+				total.bytesConsumed += load(shard.bytesConsumed);
+				total.failures += load(shard.failures);
+				for (std::size_t bucket = 0; bucket < c_latencyBuckets; bucket++)
+					total.latency[bucket] += load(shard.latency[bucket]);
+			}
+
+			if (total.getCalls() > 0)
+				stats.push_back(total);
+		}
+
+		std::ranges::stable_sort(stats, std::greater{}, &ConverterStats::getCalls);
+#endif
+		return stats;
+	}
+
+	void resetConverterStats()
+	{
+#ifdef CONVERTER_STATS
+		for (const ConverterInfo* converter : Impl::getRegisteredConverters())
+		{
+			Impl::ConverterCounters* counters = Impl::getCounters(*converter);
+			if (!counters)
+				continue;
+
+			for (auto& shard : counters->shards)
+			{
+				for (auto& calls : shard.calls)
+					calls.store(0, std::memory_order_relaxed);
+				shard.bytesProduced.store(0, std::memory_order_relaxed);
+				shard.bytesConsumed.store(0, std::memory_order_relaxed);
+				shard.failures.store(0, std::memory_order_relaxed);
+				for (auto& bucket : shard.latency)
+					bucket.store(0, std::memory_order_relaxed);
+			}
+		}
+#endif
+	}
+
+	void dumpStats()
+	{
+		if constexpr (!c_statsEnabled)
+		{
+			Log::Info().log("Converter stats are compiled out; configure with -DCONVERTER_STATS=ON to collect them");
+			return;
+		}
+
+		const std::vector<ConverterStats> stats = getConverterStats();
+		Log::Info().log("Converter stats: {} converters used", stats.size());
+		for (const auto& converter : stats)
+		{
+			Log::Info().log(
+				"{}: to string {}, from string {}, encode {}, decode {}, bytes out {}, bytes in {}, failures {}, timed {}, p50 < {} ns, p99 < {} ns",
+				converter.name, converter.toStringCalls, converter.fromStringCalls, converter.encodeCalls, converter.decodeCalls,
+				converter.bytesProduced, converter.bytesConsumed, converter.failures,
+				converter.getLatencySamples(), converter.getLatencyPercentile(0.5), converter.getLatencyPercentile(0.99)
+			);
+		}
+	}
+}
@@ -0,0 +1,294 @@
+#include <Converter/FormatSpec.h>
+
+#include <Logger/Logger.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <string_view>
+#include <system_error>
+
+#include <assert.h>
+
+namespace
+{
+	using Converter::FormatSpec;
+	using Converter::OutputBuffer;
+
+	// Room for any number to_chars writes, apart from the digits of a fixed precision or a fixed exponent
+	constexpr std::size_t c_numberSize = 64;
+
+	void logUnsupportedSpec(std::string_view typeName)
+	{
+		Log::Error().log("Format spec is not supported for {}!", typeName);
+		assert(false && "Format spec is not supported for this type!");
+	}
+
+	// Moves the text from pos to the end of out right by count characters and fills the gap
+	// Writes in place, so it only allocates when out has to grow
+	void insertFill(OutputBuffer& out, std::size_t pos, std::size_t count, char fill)
+	{
+		const std::size_t tail = out.size() - pos;
+		char* end = out.prepare(count);
+		char* begin = end - tail;
+		std::copy_backward(begin, end, end + count);
+		std::fill(begin, begin + count, fill);
+		out.commit(count);
+	}
+
+	void pad(const FormatSpec& spec, OutputBuffer& out, std::size_t start, FormatSpec::Align defaultAlign)
+	{
+		const std::size_t size = out.size() - start;
+		if (spec.width <= size)
+			return;
+
+		const std::size_t padding = spec.width - size;
+		const FormatSpec::Align align = spec.align == FormatSpec::Align::Default ? defaultAlign : spec.align;
+		const std::size_t before = align == FormatSpec::Align::Left ? 0 : align == FormatSpec::Align::Right ? padding : padding / 2;
+		if (before > 0)
+			insertFill(out, start, before, spec.fill);
+		if (padding > before)
+			insertFill(out, out.size(), padding - before, spec.fill);
+	}
+
+	// Pads a number: with zeros after its sign and base prefix for '0', with the fill character otherwise
+	void padNumber(const FormatSpec& spec, OutputBuffer& out, std::size_t start, std::size_t digitsStart, bool finite)
+	{
+		const std::size_t size = out.size() - start;
+		if (spec.zeroPad && spec.align == FormatSpec::Align::Default && finite)
+		{
+			if (spec.width > size)
+				insertFill(out, digitsStart, spec.width - size, '0');
+			return;
+		}
+		pad(spec, out, start, FormatSpec::Align::Right);
+	}
+
+	void writeSign(const FormatSpec& spec, bool negative, OutputBuffer& out)
+	{
+		if (negative)
+			out.push_back('-');
+		else if (spec.sign == FormatSpec::Sign::Plus)
+			out.push_back('+');
+		else if (spec.sign == FormatSpec::Sign::Space)
+			out.push_back(' ');
+	}
+
+	void toUpper(char* begin, char* end)
+	{
+		std::transform(begin, end, begin, [](char c) { return static_cast<char>(std::toupper(static_cast<unsigned char>(c))); });
+	}
+
+	void formatMagnitude(bool negative, std::uint64_t magnitude, const FormatSpec& spec, OutputBuffer& out)
+	{
+		constexpr std::string_view c_integerTypes = "bBdoxX";
+		if (spec.precision >= 0 || (spec.type != '\0' && c_integerTypes.find(spec.type) == std::string_view::npos))
+			logUnsupportedSpec("integers");
+
+		int base = 10;
+		std::string_view prefix;
+		switch (spec.type)
+		{
+		case 'b':
+		case 'B':
+			base = 2;
+			prefix = spec.type == 'b' ? "0b" : "0B";
+			break;
+		case 'o':
+			base = 8;
+			// Like printf, zero is just "0"
+			prefix = magnitude != 0 ? "0" : "";
+			break;
+		case 'x':
+		case 'X':
+			base = 16;
+			prefix = spec.type == 'x' ? "0x" : "0X";
+			break;
+		default:
+			break;
+		}
+
+		const std::size_t start = out.size();
+		writeSign(spec, negative, out);
+		if (spec.alternate)
+			out.append(prefix);
+
+		const std::size_t digitsStart = out.size();
+		char* dst = out.prepare(c_numberSize);
+		char* end = std::to_chars(dst, dst + c_numberSize, magnitude, base).ptr;
+		if (spec.type == 'X')
+			toUpper(dst, end);
+		out.commit(static_cast<std::size_t>(end - dst));
+
+		padNumber(spec, out, start, digitsStart, true);
+	}
+
+	// Position of the exponent of a formatted float, or its end if it has none
+	std::size_t findExponent(std::string_view text, bool hex)
+	{
+		const std::size_t pos = text.find_first_of(hex ? "pP" : "eE");
+		return pos == std::string_view::npos ? text.size() : pos;
+	}
+
+	template<typename T>
+	void formatFloatImpl(T val, const FormatSpec& spec, OutputBuffer& out)
+	{
+		constexpr std::string_view c_floatTypes = "aAeEfFgG";
+		if (spec.type != '\0' && c_floatTypes.find(spec.type) == std::string_view::npos)
+			logUnsupportedSpec("floating point values");
+
+		const bool finite = std::isfinite(val);
+		const std::size_t start = out.size();
+		writeSign(spec, std::signbit(val), out);
+		const std::size_t digitsStart = out.size();
+
+		const T magnitude = std::abs(val);
+		const char type = static_cast<char>(std::tolower(static_cast<unsigned char>(spec.type)));
+		const int precision = spec.precision >= 0 || type == 'a' || type == '\0' ? spec.precision : 6;
+
+		// Fixed notation writes every digit before the point
+		const std::size_t capacity = c_numberSize + static_cast<std::size_t>(std::max(precision, 0))
+			+ (type == 'f' ? static_cast<std::size_t>(std::numeric_limits<T>::max_exponent10) : 0);
+		char* dst = out.prepare(capacity);
+		char* last = dst + capacity;
+
+		std::to_chars_result result;
+		switch (type)
+		{
+		case 'a':
+			result = precision < 0 ? std::to_chars(dst, last, magnitude, std::chars_format::hex) : std::to_chars(dst, last, magnitude, std::chars_format::hex, precision);
+			break;
+		case 'e':
+			result = std::to_chars(dst, last, magnitude, std::chars_format::scientific, precision);
+			break;
+		case 'f':
+			result = std::to_chars(dst, last, magnitude, std::chars_format::fixed, precision);
+			break;
+		case 'g':
+			result = std::to_chars(dst, last, magnitude, std::chars_format::general, precision);
+			break;
+		default:
+			result = precision < 0 ? std::to_chars(dst, last, magnitude) : std::to_chars(dst, last, magnitude, std::chars_format::general, precision);
+			break;
+		}
+		assert(result.ec == std::errc() && "Float buffer too small!");
+
+		if (spec.type == 'A' || spec.type == 'E' || spec.type == 'F' || spec.type == 'G')
+			toUpper(dst, result.ptr);
+		out.commit(static_cast<std::size_t>(result.ptr - dst));
+
+		// '#' always writes a decimal point, and for 'g' (or no type with a precision) keeps the trailing zeros up to the precision
+		if (spec.alternate && finite)
+		{
+			std::string_view text = out.view().substr(digitsStart);
+			std::size_t exponent = findExponent(text, type == 'a');
+			if (text.find('.') == std::string_view::npos)
+			{
+				insertFill(out, digitsStart + exponent, 1, '.');
+				text = out.view().substr(digitsStart);
+				exponent++;
+			}
+
+			if (type == 'g' || (type == '\0' && precision >= 0))
+			{
+				const std::string_view mantissa = text.substr(0, exponent);
+				const std::size_t digits = static_cast<std::size_t>(std::ranges::count_if(mantissa, [](char c) { return c >= '0' && c <= '9'; }));
+				const std::size_t firstSignificant = mantissa.find_first_of("123456789");
+				// Zeros before the first significant digit don't count, unless the value is zero
+				const std::size_t leadingZeros = firstSignificant == std::string_view::npos ? 0
+					: static_cast<std::size_t>(std::ranges::count(mantissa.substr(0, firstSignificant), '0'));
+				const std::size_t wanted = static_cast<std::size_t>(std::max(precision, 1));
+				if (digits - leadingZeros < wanted)
+					insertFill(out, digitsStart + exponent, wanted - (digits - leadingZeros), '0');
+			}
+		}
+
+		padNumber(spec, out, start, digitsStart, finite);
+	}
+}
+
+namespace Converter::Impl
+{
+	void formatInteger(std::int64_t val, const FormatSpec& spec, OutputBuffer& out)
+	{
+		// Negating in unsigned arithmetic also works for the minimum value
+		const std::uint64_t magnitude = val < 0 ? 0 - static_cast<std::uint64_t>(val) : static_cast<std::uint64_t>(val);
+		formatMagnitude(val < 0, magnitude, spec, out);
+	}
+
+	void formatInteger(std::uint64_t val, const FormatSpec& spec, OutputBuffer& out)
+	{
+		formatMagnitude(false, val, spec, out);
+	}
+
+	void formatFloat(float val, const FormatSpec& spec, OutputBuffer& out)
+	{
+		formatFloatImpl(val, spec, out);
+	}
+
+	void formatFloat(double val, const FormatSpec& spec, OutputBuffer& out)
+	{
+		formatFloatImpl(val, spec, out);
+	}
+
+	void formatFloat(long double val, const FormatSpec& spec, OutputBuffer& out)
+	{
+		formatFloatImpl(val, spec, out);
+	}
+
+	void formatString(std::string_view val, const FormatSpec& spec, OutputBuffer& out)
+	{
+		if (spec.sign != FormatSpec::Sign::Default || spec.alternate || spec.zeroPad || (spec.type != '\0' && spec.type != 's'))
+			logUnsupportedSpec("strings");
+
+		const std::size_t start = out.size();
+		if (spec.precision >= 0 && static_cast<std::size_t>(spec.precision) < val.size())
+			val = val.substr(0, static_cast<std::size_t>(spec.precision));
+		out.append(val);
+		pad(spec, out, start, FormatSpec::Align::Left);
+	}
+
+	void formatBool(bool val, const FormatSpec& spec, OutputBuffer& out)
+	{
+		if (spec.type == '\0' || spec.type == 's')
+		{
+			// Without a type bool keeps the 1 / 0 of its converter
+			FormatSpec textSpec = spec;
+			textSpec.type = '\0';
+			formatString(spec.type == 's' ? (val ? "true" : "false") : (val ? "1" : "0"), textSpec, out);
+		}
+		else
+		{
+			formatInteger(static_cast<std::uint64_t>(val), spec, out);
+		}
+	}
+
+	void formatChar(char val, const FormatSpec& spec, OutputBuffer& out)
+	{
+		if (spec.type == '\0' || spec.type == 'c')
+		{
+			if (spec.precision >= 0)
+				logUnsupportedSpec("chars");
+
+			FormatSpec textSpec = spec;
+			textSpec.type = '\0';
+			textSpec.precision = -1;
+			formatString(std::string_view(&val, 1), textSpec, out);
+		}
+		else
+		{
+			// Like std::format, the code of the character is its unsigned value
+			formatInteger(static_cast<std::uint64_t>(static_cast<unsigned char>(val)), spec, out);
+		}
+	}
+
+	void alignFormatted(const FormatSpec& spec, OutputBuffer& out, std::size_t start)
+	{
+		if (spec.sign != FormatSpec::Sign::Default || spec.alternate || spec.zeroPad || spec.precision >= 0 || spec.type != '\0')
+			logUnsupportedSpec("this type; only fill, align and width are");
+
+		pad(spec, out, start, FormatSpec::Align::Left);
+	}
+}
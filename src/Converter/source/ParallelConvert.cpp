@@ -0,0 +1,261 @@
+#include <Converter/ParallelConvert.h>
+
+#include <Logger/Logger.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+	using Converter::Impl::ParallelTask;
+
+	// Set on pool threads, and on the calling thread while it works on a job, so that conversions
+	// started from inside a task run inline instead of waiting on the pool they are running on
+	thread_local bool t_inPool = false;
+
+	// Fixed size thread pool running one job of numbered tasks at a time
+	// A job's tasks are dealt out as contiguous ranges, one per thread; a thread works through its own range
+	// from the front and, once it is empty, steals single tasks from the back of the others.
+	class WorkStealingPool
+	{
+	public:
+		explicit WorkStealingPool(std::size_t workerCount)
+			: m_queues(std::make_unique<Queue[]>(workerCount + 1))
+			, m_queueCount(workerCount + 1)
+		{
+			m_workers.reserve(workerCount);
+			for (std::size_t i = 0; i < workerCount; i++)
+				m_workers.emplace_back([this, i]() { workerLoop(i); });
+		}
+
+		~WorkStealingPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_stop = true;
+			}
+			m_wake.notify_all();
+			for (auto& worker : m_workers)
+				worker.join();
+		}
+
+		std::size_t getThreadCount() const { return m_queueCount; }
+
+		WorkStealingPool(const WorkStealingPool&) = delete;
+		WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+		void run(std::size_t taskCount, const ParallelTask& task)
+		{
+			if (taskCount == 0)
+				return;
+
+			if (m_workers.empty() || taskCount == 1 || t_inPool || !m_runMutex.try_lock())
+			{
+				for (std::size_t i = 0; i < taskCount; i++)
+					task(i);
+				return;
+			}
+
+			std::lock_guard<std::mutex> runLock(m_runMutex, std::adopt_lock);
+			for (std::size_t i = 0; i < m_queueCount; i++)
+			{
+				std::lock_guard<std::mutex> lock(m_queues[i].mutex);
+				m_queues[i].next = taskCount * i / m_queueCount;
+				m_queues[i].end = taskCount * (i + 1) / m_queueCount;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_task = &task;
+				m_activeWorkers = m_workers.size();
+				m_generation++;
+			}
+			m_wake.notify_all();
+
+			// The calling thread takes the last queue
+			t_inPool = true;
+			work(m_queueCount - 1, task);
+			t_inPool = false;
+
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_done.wait(lock, [this]() { return m_activeWorkers == 0; });
+			m_task = nullptr;
+		}
+
+	private:
+		struct alignas(64) Queue
+		{
+			std::mutex mutex;
+			std::size_t next = 0;
+			std::size_t end = 0;
+		};
+
+		bool takeOwn(std::size_t queue, std::size_t& task)
+		{
+			Queue& own = m_queues[queue];
+			std::lock_guard<std::mutex> lock(own.mutex);
+			if (own.next == own.end)
+				return false;
+			task = own.next++;
+			return true;
+		}
+
+		bool steal(std::size_t queue, std::size_t& task)
+		{
+			for (std::size_t i = 1; i < m_queueCount; i++)
+			{
+				Queue& victim = m_queues[(queue + i) % m_queueCount];
+				std::lock_guard<std::mutex> lock(victim.mutex);
+				if (victim.next != victim.end)
+				{
+					task = --victim.end;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// Runs tasks until every queue is empty; no tasks are added during a job
+		void work(std::size_t queue, const ParallelTask& func)
+		{
+			std::size_t task = 0;
+			while (takeOwn(queue, task) || steal(queue, task))
+				func(task);
+		}
+
+		void workerLoop(std::size_t queue)
+		{
+			t_inPool = true;
+			std::uint64_t seenGeneration = 0;
+			while (true)
+			{
+				const ParallelTask* task = nullptr;
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+					m_wake.wait(lock, [&]() { return m_stop || m_generation != seenGeneration; });
+					if (m_stop)
+						return;
+					seenGeneration = m_generation;
+					task = m_task;
+				}
+
+				work(queue, *task);
+
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (--m_activeWorkers == 0)
+					m_done.notify_one();
+			}
+		}
+
+		std::vector<std::thread> m_workers;
+		// One queue per worker, and the last one for the thread calling run
+		std::unique_ptr<Queue[]> m_queues;
+		std::size_t m_queueCount;
+
+		// Held for the whole of a job
+		std::mutex m_runMutex;
+		// Guards the job state below
+		std::mutex m_mutex;
+		std::condition_variable m_wake;
+		std::condition_variable m_done;
+		const ParallelTask* m_task = nullptr;
+		std::uint64_t m_generation = 0;
+		// Workers that haven't finished the current job yet
+		std::size_t m_activeWorkers = 0;
+		bool m_stop = false;
+	};
+
+	std::mutex g_poolMutex;
+	std::unique_ptr<WorkStealingPool> g_pool;
+	std::size_t g_threadCount = 0;
+
+	WorkStealingPool& getPool()
+	{
+		std::lock_guard<std::mutex> lock(g_poolMutex);
+		if (!g_pool)
+		{
+			const std::size_t threadCount = g_threadCount > 0 ? g_threadCount : std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+			g_pool = std::make_unique<WorkStealingPool>(threadCount - 1);
+		}
+		return *g_pool;
+	}
+}
+
+namespace Converter::Impl
+{
+	void parallelFor(std::size_t taskCount, const ParallelTask& task)
+	{
+		getPool().run(taskCount, task);
+	}
+
+	void setParallelThreadCount(std::size_t threadCount)
+	{
+		std::lock_guard<std::mutex> lock(g_poolMutex);
+		if (g_pool)
+		{
+			Log::Warn().log("The parallel conversion pool is already running; the thread count can't be changed");
+			return;
+		}
+		g_threadCount = threadCount;
+	}
+
+	std::size_t getParallelThreadCount()
+	{
+		return getPool().getThreadCount();
+	}
+
+	std::vector<DelimitedChunk> splitDelimited(std::string_view str, char delimiter)
+	{
+		std::vector<DelimitedChunk> chunks;
+		chunks.reserve(str.size() / c_parallelChunkBytes + 1);
+		std::size_t begin = 0;
+		while (true)
+		{
+			// Only the end of a chunk is searched for serially; the values inside are counted in parallel
+			const std::size_t end = begin + c_parallelChunkBytes < str.size() ? str.find(delimiter, begin + c_parallelChunkBytes) : std::string_view::npos;
+			if (end == std::string_view::npos)
+			{
+				chunks.push_back(DelimitedChunk{ str.substr(begin), 0, 0 });
+				break;
+			}
+
+			chunks.push_back(DelimitedChunk{ str.substr(begin, end - begin), 0, 0 });
+			begin = end + 1;
+		}
+
+		parallelFor(chunks.size(), [&chunks, delimiter](std::size_t i)
+			{
+				chunks[i].count = static_cast<std::size_t>(std::ranges::count(chunks[i].text, delimiter)) + 1;
+			});
+
+		std::size_t index = 0;
+		for (auto& chunk : chunks)
+		{
+			chunk.firstIndex = index;
+			index += chunk.count;
+		}
+		return chunks;
+	}
+
+	void joinChunks(std::span<const OutputBuffer> chunks, OutputBuffer& out)
+	{
+		std::vector<std::size_t> offsets(chunks.size());
+		std::size_t total = 0;
+		for (std::size_t i = 0; i < chunks.size(); i++)
+		{
+			offsets[i] = total;
+			total += chunks[i].size();
+		}
+
+		char* dst = out.prepare(total);
+		parallelFor(chunks.size(), [chunks, &offsets, dst](std::size_t i)
+			{
+				std::memcpy(dst + offsets[i], chunks[i].data(), chunks[i].size());
+			});
+		out.commit(total);
+	}
+}
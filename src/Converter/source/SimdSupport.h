@@ -0,0 +1,63 @@
+#pragma once
+
+// Private to the Converter library: runtime selection of the SIMD kernels used by BatchConvert and ByteEncoding
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CONVERTER_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only emit SIMD instructions in functions marked for them; MSVC always can
+#if defined(CONVERTER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CONVERTER_TARGET_SSE41 __attribute__((target("sse4.1")))
+#else
+#define CONVERTER_TARGET_SSE41
+#endif
+
+namespace Converter::Impl
+{
+	enum class KernelLevel
+	{
+		Scalar,
+		Sse41, // Also implies SSSE3 (pshufb)
+	};
+
+	inline KernelLevel detectKernelLevel()
+	{
+#if defined(CONVERTER_X86) && defined(_MSC_VER)
+		int info[4] = {};
+		__cpuid(info, 1);
+		if (info[2] & (1 << 19))
+			return KernelLevel::Sse41;
+		return KernelLevel::Scalar;
+#elif defined(CONVERTER_X86)
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("sse4.1"))
+			return KernelLevel::Sse41;
+		return KernelLevel::Scalar;
+#else
+		return KernelLevel::Scalar;
+#endif
+	}
+
+	// Detected once per process
+	inline KernelLevel getKernelLevel()
+	{
+		static const KernelLevel level = detectKernelLevel();
+		return level;
+	}
+
+	inline const char* getKernelLevelName(KernelLevel level)
+	{
+		switch (level)
+		{
+		case KernelLevel::Sse41:
+			return "sse4.1";
+		default:
+			return "scalar";
+		}
+	}
+}
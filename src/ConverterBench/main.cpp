@@ -0,0 +1,796 @@
+#include <Logger/Logger.h>
+#include <Converter/Converter.h>
+#include <Converter/BatchConvert.h>
+#include <Converter/BulkReader.h>
+#include <Converter/ParallelConvert.h>
+
+#include <any>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+// Converter benchmark suite
+// Measures ns/op and heap allocations/op of every built-in converter in both directions through each
+// way of reaching it: the typed templates, the registry by type index and by name, and std::to_chars /
+// std::from_chars as the baseline. Registry lookups are then measured as the registry grows to 5000 converters.
+//
+// Usage: ConverterBench [output.json]
+// The results are written as JSON to the given file, or to stdout; the log goes to stderr.
+namespace
+{
+	constexpr std::size_t c_valueCount = 1 << 16;
+	constexpr int c_repetitions = 20;
+	constexpr std::array<std::size_t, 3> c_registrySizes = { 50, 500, 5000 };
+
+	// Keeps the optimizer from discarding benchmark results
+	volatile std::size_t g_sink = 0;
+
+	// Every call to the global operator new in the process, see the replacement below main's namespace
+	std::atomic<std::size_t> g_allocations = 0;
+
+	struct Measurement
+	{
+		double nsPerOp;
+		double allocsPerOp;
+	};
+
+	struct Result
+	{
+		std::string group;
+		std::string type;
+		std::string operation;
+		std::string path;
+		std::size_t registrySize;
+		Measurement measurement;
+	};
+
+	std::vector<Result> g_results;
+
+	// Runs func once to warm up, then times c_repetitions runs of opsPerRun operations each
+	template <typename Func>
+	Measurement measure(std::size_t opsPerRun, Func func)
+	{
+		func();
+		const std::size_t allocations = g_allocations.load(std::memory_order_relaxed);
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < c_repetitions; i++)
+			func();
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		const double ops = double(opsPerRun) * c_repetitions;
+		return Measurement
+		{
+			.nsPerOp = std::chrono::duration<double, std::nano>(elapsed).count() / ops,
+			.allocsPerOp = double(g_allocations.load(std::memory_order_relaxed) - allocations) / ops,
+		};
+	}
+
+	void record(std::string group, std::string type, std::string operation, std::string path, Measurement measurement, std::size_t registrySize = 0)
+	{
+		g_results.push_back(Result{ std::move(group), std::move(type), std::move(operation), std::move(path), registrySize, measurement });
+	}
+
+	// Folds a converted value into g_sink
+	template <typename T>
+	std::size_t sinkValue(const T& val)
+	{
+		// Casting a negative or out of range floating point value to an integer is undefined; fold its bits instead
+		if constexpr (std::is_same_v<T, float>)
+			return std::bit_cast<std::uint32_t>(val);
+		else if constexpr (std::is_same_v<T, double>)
+			return static_cast<std::size_t>(std::bit_cast<std::uint64_t>(val));
+		else if constexpr (std::is_arithmetic_v<T>)
+			return static_cast<std::size_t>(val);
+		else if constexpr (std::is_enum_v<T>)
+			return static_cast<std::size_t>(val);
+		else if constexpr (requires { val.count(); })
+			return static_cast<std::size_t>(val.count());
+		else if constexpr (requires { val.time_since_epoch(); })
+			return static_cast<std::size_t>(val.time_since_epoch().count());
+		else
+			return val.size();
+	}
+
+	template <typename T>
+	T generate(std::mt19937_64& rng)
+	{
+		if constexpr (std::is_same_v<T, bool>)
+			return (rng() & 1) != 0;
+		else if constexpr (std::is_same_v<T, char>)
+			return static_cast<char>('a' + rng() % 26);
+		else if constexpr (std::is_integral_v<T>)
+			return static_cast<T>(rng());
+		else if constexpr (std::is_floating_point_v<T>)
+			return std::uniform_real_distribution<T>(T(-1e6), T(1e6))(rng);
+		else if constexpr (std::is_enum_v<T>)
+		{
+			using Table = Converter::Impl::EnumTable<T>;
+			return Table::c_sorted[rng() % Table::c_count].value;
+		}
+		else if constexpr (std::is_same_v<T, std::string>)
+			return "name" + Converter::getStringForType(rng() % 100000);
+		else
+		{
+			// The built-in composites are vectors
+			T val;
+			for (int i = 0; i < 4; i++)
+				val.push_back(generate<typename T::value_type>(rng));
+			return val;
+		}
+	}
+
+	// Both directions of one built-in converter through every path that reaches it
+	template <typename T>
+	void benchType(std::mt19937_64& rng)
+	{
+		const auto* converter = Converter::Impl::findConverter(std::type_index(typeid(T)), true);
+		if (!converter)
+			return;
+		const std::string name(converter->name);
+		const std::type_index index(typeid(T));
+		const std::size_t registrySize = Converter::Impl::getRegisteredConverters().size();
+
+		std::vector<T> values;
+		std::vector<std::any> anys;
+		std::vector<std::string> strings;
+		for (std::size_t i = 0; i < c_valueCount; i++)
+		{
+			values.push_back(generate<T>(rng));
+			anys.emplace_back(values.back());
+			strings.push_back(Converter::getStringForType(values.back()));
+		}
+
+		Converter::OutputBuffer out;
+		auto toString = [&](const char* path, auto convert)
+			{
+				record("convert", name, "toString", path, measure(c_valueCount, [&]()
+					{
+						for (std::size_t i = 0; i < c_valueCount; i++)
+							g_sink = g_sink + convert(i);
+					}), registrySize);
+			};
+		auto fromString = [&](const char* path, auto convert)
+			{
+				record("convert", name, "fromString", path, measure(c_valueCount, [&]()
+					{
+						for (const auto& str : strings)
+							g_sink = g_sink + convert(std::string_view(str));
+					}), registrySize);
+			};
+
+		toString("typed", [&](std::size_t i) { return Converter::getStringForType(values[i]).size(); });
+		toString("typed_buffer", [&](std::size_t i) { out.clear(); Converter::getStringForType(values[i], out); return out.size(); });
+		toString("type_index", [&](std::size_t i) { out.clear(); Converter::getStringFromAny(index, anys[i], out); return out.size(); });
+		toString("name", [&](std::size_t i) { out.clear(); Converter::getStringFromAny(std::string_view(name), anys[i], out); return out.size(); });
+
+		fromString("typed", [](std::string_view str) { return sinkValue(Converter::getTypeFromString<T>(str)); });
+		fromString("try_parse", [](std::string_view str) { return sinkValue(*Converter::tryParse<T>(str)); });
+		fromString("type_index", [&](std::string_view str) { return std::size_t(Converter::getAnyFromString(index, str).has_value()); });
+		fromString("name", [&](std::string_view str) { return std::size_t(Converter::getAnyFromString(std::string_view(name), str).has_value()); });
+
+		// std::to_chars / std::from_chars, the floor every path above is built on
+		if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>)
+		{
+			toString("baseline", [&](std::size_t i)
+				{
+					char buffer[128];
+					return static_cast<std::size_t>(std::to_chars(buffer, buffer + sizeof(buffer), values[i]).ptr - buffer);
+				});
+			fromString("baseline", [](std::string_view str)
+				{
+					T val{};
+					std::from_chars(str.data(), str.data() + str.size(), val);
+					return sinkValue(val);
+				});
+		}
+	}
+
+	// Compares the built-in converters against the std::to_string / std::sto* implementation they replaced
+	template <typename T, typename LegacyTo, typename LegacyFrom>
+	void benchLegacy(std::mt19937_64& rng, LegacyTo legacyTo, LegacyFrom legacyFrom)
+	{
+		const std::string name(Converter::Impl::findConverter(std::type_index(typeid(T)), true)->name);
+
+		std::vector<T> values;
+		std::vector<std::string> legacyStrings;
+		for (std::size_t i = 0; i < c_valueCount; i++)
+		{
+			values.push_back(generate<T>(rng));
+			legacyStrings.push_back(legacyTo(values.back()));
+		}
+
+		record("legacy", name, "toString", "std::to_string", measure(c_valueCount, [&]() { for (const auto& val : values) g_sink = g_sink + legacyTo(val).size(); }));
+		record("legacy", name, "fromString", "std::sto*", measure(c_valueCount, [&]() { for (const auto& str : legacyStrings) g_sink = g_sink + static_cast<std::size_t>(legacyFrom(str)); }));
+	}
+
+	// Per-conversion cost of going through the registry's type erased functions
+	// The old layout wrapped the user's std::function in a second std::function taking std::any;
+	// ConverterInfo now holds a small-buffer thunk that calls the converter directly
+	void benchDispatch()
+	{
+		std::vector<std::any> values;
+		for (std::size_t i = 0; i < c_valueCount; i++)
+			values.emplace_back(static_cast<int>(i * 2654435761u));
+
+		Converter::OutputBuffer out;
+		auto run = [&](const char* path, auto convert)
+			{
+				record("dispatch", "int", "toString", path, measure(c_valueCount, [&]()
+					{
+						for (const auto& val : values)
+						{
+							out.clear();
+							convert(val, out);
+							g_sink = g_sink + out.size();
+						}
+					}));
+			};
+
+		const std::function<void(const int&, Converter::OutputBuffer&)> inner = &Converter::Traits<int>::toChars;
+		const std::function<void(const std::any&, Converter::OutputBuffer&)> nested = [inner](const std::any& val, Converter::OutputBuffer& out) { inner(std::any_cast<const int&>(val), out); };
+		const auto* converter = Converter::Impl::findConverter(std::type_index(typeid(int)));
+
+		run("direct", [](const std::any& val, Converter::OutputBuffer& out) { Converter::Traits<int>::toChars(std::any_cast<const int&>(val), out); });
+		run("nested_std_function", [&nested](const std::any& val, Converter::OutputBuffer& out) { nested(val, out); });
+		run("registry_thunk", [converter](const std::any& val, Converter::OutputBuffer& out) { converter->toChars(val, out); });
+	}
+
+	// Parsing a delimited file: getline + one getTypeFromString per cell against the columnar BulkReader
+	void benchBulk(std::mt19937_64& rng)
+	{
+		std::string csv;
+		for (std::size_t i = 0; i < c_valueCount; i++)
+		{
+			csv += Converter::getStringForType(static_cast<int>(rng()));
+			csv += ',';
+			csv += Converter::getStringForType(static_cast<double>(rng() % 1000000) / 7.0);
+			csv += ",name";
+			csv += Converter::getStringForType(i);
+			csv += '\n';
+		}
+
+		record("bulk", "int,double,std::string", "fromString", "getline", measure(c_valueCount, [&]()
+			{
+				std::istringstream stream(csv);
+				std::vector<int> ints;
+				std::vector<double> doubles;
+				std::vector<std::string> names;
+				std::string line;
+				while (std::getline(stream, line))
+				{
+					std::istringstream fields(line);
+					std::string field;
+					std::getline(fields, field, ',');
+					ints.push_back(Converter::getTypeFromString<int>(field));
+					std::getline(fields, field, ',');
+					doubles.push_back(Converter::getTypeFromString<double>(field));
+					std::getline(fields, field, ',');
+					names.push_back(Converter::getTypeFromString<std::string>(field));
+				}
+				g_sink = g_sink + ints.size() + doubles.size() + names.size();
+			}));
+
+		using Reader = Converter::BulkReader<int, double, std::string>;
+		Reader::Columns columns;
+		record("bulk", "int,double,std::string", "fromString", "bulk_reader", measure(c_valueCount, [&]()
+			{
+				std::istringstream stream(csv);
+				Reader reader(stream);
+				while (auto rows = reader.read(columns, 4096))
+				{
+					if (*rows == 0)
+						break;
+					g_sink = g_sink + *rows;
+				}
+			}));
+	}
+
+	// Whole arrays through toStrings / fromStrings against one getStringForType / tryParse call per value
+	template <typename T>
+	void benchBatch(std::mt19937_64& rng)
+	{
+		const std::string name(Converter::Impl::findConverter(std::type_index(typeid(T)), true)->name);
+		const std::string batchPath = "batch_" + std::string(Converter::Impl::getBatchKernelName());
+
+		std::vector<T> values;
+		for (std::size_t i = 0; i < c_valueCount; i++)
+			values.push_back(generate<T>(rng));
+
+		Converter::OutputBuffer out;
+		record("batch", name, "toString", "per_value", measure(c_valueCount, [&]()
+			{
+				out.clear();
+				for (std::size_t i = 0; i < values.size(); i++)
+				{
+					if (i > 0)
+						out.push_back(',');
+					Converter::getStringForType(values[i], out);
+				}
+				g_sink = g_sink + out.size();
+			}));
+		record("batch", name, "toString", batchPath, measure(c_valueCount, [&]()
+			{
+				out.clear();
+				Converter::toStrings<T>(values, out);
+				g_sink = g_sink + out.size();
+			}));
+
+		const std::string text = out.str();
+		std::vector<T> parsed(values.size());
+		record("batch", name, "fromString", "per_value", measure(c_valueCount, [&]()
+			{
+				std::string_view str = text;
+				for (std::size_t i = 0; i < parsed.size(); i++)
+				{
+					const std::size_t end = str.find(',');
+					parsed[i] = *Converter::tryParse<T>(str.substr(0, end));
+					str.remove_prefix(end == std::string_view::npos ? str.size() : end + 1);
+				}
+				g_sink = g_sink + sinkValue(parsed.back());
+			}));
+		record("batch", name, "fromString", batchPath, measure(c_valueCount, [&]()
+			{
+				g_sink = g_sink + *Converter::fromStrings<T>(text, parsed);
+			}));
+	}
+
+	// Large arrays through parallelToStrings / parallelFromStrings against the single threaded toStrings / fromStrings
+	template <typename T>
+	void benchParallel(std::mt19937_64& rng)
+	{
+		constexpr std::size_t c_parallelValueCount = 1 << 20;
+		const std::string name(Converter::Impl::findConverter(std::type_index(typeid(T)), true)->name);
+		const std::string parallelPath = "parallel_" + std::to_string(std::max(std::thread::hardware_concurrency(), 1u)) + "t";
+
+		std::vector<T> values;
+		for (std::size_t i = 0; i < c_parallelValueCount; i++)
+			values.push_back(generate<T>(rng));
+
+		Converter::OutputBuffer out;
+		record("parallel", name, "toString", "serial", measure(c_parallelValueCount, [&]()
+			{
+				out.clear();
+				Converter::toStrings<T>(values, out);
+				g_sink = g_sink + out.size();
+			}));
+		record("parallel", name, "toString", parallelPath, measure(c_parallelValueCount, [&]()
+			{
+				out.clear();
+				Converter::parallelToStrings<T>(values, out);
+				g_sink = g_sink + out.size();
+			}));
+
+		// Keeping the chunks skips the final copy, as when writing them out with vectored I/O
+		std::vector<Converter::OutputBuffer> chunks;
+		record("parallel", name, "toString", parallelPath + "_chunks", measure(c_parallelValueCount, [&]()
+			{
+				Converter::parallelToStrings<T>(values, chunks);
+				g_sink = g_sink + chunks.size();
+			}));
+
+		const std::string text = out.str();
+		std::vector<T> parsed(values.size());
+		record("parallel", name, "fromString", "serial", measure(c_parallelValueCount, [&]()
+			{
+				g_sink = g_sink + *Converter::fromStrings<T>(text, parsed);
+			}));
+		record("parallel", name, "fromString", parallelPath, measure(c_parallelValueCount, [&]()
+			{
+				g_sink = g_sink + *Converter::parallelFromStrings<T>(text, parsed);
+			}));
+	}
+
+	// Hex / base64 byte buffers through encodeBytes / decodeBytes, with the stringstream hex code they replace as the baseline
+	void benchBytes(std::mt19937_64& rng)
+	{
+		constexpr std::size_t c_bufferCount = 256;
+		for (std::size_t size : { std::size_t(32), std::size_t(4096) })
+		{
+			std::vector<std::vector<std::byte>> buffers(c_bufferCount, std::vector<std::byte>(size));
+			for (auto& buffer : buffers)
+				for (auto& byte : buffer)
+					byte = static_cast<std::byte>(rng());
+
+			for (auto encoding : { Converter::ByteEncoding::Hex, Converter::ByteEncoding::Base64 })
+			{
+				const std::string type = std::format("{}_{}B", encoding == Converter::ByteEncoding::Hex ? "hex" : "base64", size);
+
+				Converter::OutputBuffer out;
+				std::vector<std::string> texts;
+				for (const auto& buffer : buffers)
+				{
+					out.clear();
+					Converter::encodeBytes(encoding, buffer, out);
+					texts.push_back(out.str());
+				}
+
+				record("bytes", type, "toString", "codec", measure(c_bufferCount, [&]()
+					{
+						for (const auto& buffer : buffers)
+						{
+							out.clear();
+							Converter::encodeBytes(encoding, buffer, out);
+							g_sink = g_sink + out.size();
+						}
+					}));
+
+				std::vector<std::byte> decoded(size);
+				record("bytes", type, "fromString", "codec", measure(c_bufferCount, [&]()
+					{
+						for (const auto& text : texts)
+							g_sink = g_sink + *Converter::decodeBytes(encoding, text, decoded);
+					}));
+
+				if (encoding != Converter::ByteEncoding::Hex)
+					continue;
+
+				record("bytes", type, "toString", "stringstream", measure(c_bufferCount, [&]()
+					{
+						for (const auto& buffer : buffers)
+						{
+							std::ostringstream stream;
+							stream << std::hex << std::setfill('0');
+							for (std::byte byte : buffer)
+								stream << std::setw(2) << static_cast<int>(byte);
+							g_sink = g_sink + stream.str().size();
+						}
+					}));
+				record("bytes", type, "fromString", "stringstream", measure(c_bufferCount, [&]()
+					{
+						for (const auto& text : texts)
+						{
+							for (std::size_t i = 0; i < size; i++)
+							{
+								std::istringstream stream(text.substr(i * 2, 2));
+								int byte = 0;
+								stream >> std::hex >> byte;
+								decoded[i] = static_cast<std::byte>(byte);
+							}
+							g_sink = g_sink + static_cast<std::size_t>(decoded.back());
+						}
+					}));
+			}
+		}
+	}
+
+	// ISO-8601 timestamps and durations, against std::format and std::chrono::parse for the timestamps
+	void benchChrono(std::mt19937_64& rng)
+	{
+		using Timestamp = std::chrono::sys_time<std::chrono::nanoseconds>;
+		constexpr std::size_t c_chronoCount = 4096;
+		constexpr std::int64_t c_range = std::int64_t(130) * 365 * 86400 * 1'000'000'000;
+
+		std::vector<Timestamp> timestamps(c_chronoCount);
+		std::vector<std::chrono::milliseconds> durations(c_chronoCount);
+		for (std::size_t i = 0; i < c_chronoCount; i++)
+		{
+			timestamps[i] = Timestamp{ std::chrono::nanoseconds{ static_cast<std::int64_t>(rng() % c_range) } };
+			durations[i] = std::chrono::milliseconds{ static_cast<std::int64_t>(rng() % (std::uint64_t(86400) * 1000 * 400)) };
+		}
+
+		auto benchCodec = [&]<typename T>(const std::string& type, const std::vector<T>& values)
+		{
+			std::vector<std::string> texts;
+			for (const auto& val : values)
+				texts.push_back(Converter::getStringForType(val));
+
+			Converter::OutputBuffer out;
+			record("chrono", type, "toString", "codec", measure(c_chronoCount, [&]()
+				{
+					for (const auto& val : values)
+					{
+						out.clear();
+						Converter::getStringForType(val, out);
+						g_sink = g_sink + out.size();
+					}
+				}));
+			record("chrono", type, "fromString", "codec", measure(c_chronoCount, [&]()
+				{
+					for (const auto& text : texts)
+						g_sink = g_sink + sinkValue(*Converter::tryParse<T>(text));
+				}));
+			return texts;
+		};
+
+		const auto texts = benchCodec("timestamp", timestamps);
+		benchCodec("duration", durations);
+
+		record("chrono", "timestamp", "toString", "std_format", measure(c_chronoCount, [&]()
+			{
+				for (const auto& val : timestamps)
+					g_sink = g_sink + std::format("{:%FT%TZ}", val).size();
+			}));
+#if __cpp_lib_chrono >= 201907L
+		record("chrono", "timestamp", "fromString", "chrono_parse", measure(c_chronoCount, [&]()
+			{
+				for (const auto& text : texts)
+				{
+					std::istringstream stream(text);
+					Timestamp val;
+					stream >> std::chrono::parse("%FT%TZ", val);
+					g_sink = g_sink + sinkValue(val);
+				}
+			}));
+#endif
+	}
+
+	// Pre-parsed format specs against std::format parsing its spec for every value
+	void benchFormatSpecs(std::mt19937_64& rng)
+	{
+		constexpr std::size_t c_formatCount = 4096;
+
+		std::vector<double> doubles(c_formatCount);
+		std::vector<std::int64_t> integers(c_formatCount);
+		for (std::size_t i = 0; i < c_formatCount; i++)
+		{
+			doubles[i] = std::uniform_real_distribution<double>(-1e6, 1e6)(rng);
+			integers[i] = static_cast<std::int64_t>(rng());
+		}
+
+		auto bench = [&]<typename T>(const std::string& type, const std::vector<T>& values, std::string_view specText, auto formatStd)
+		{
+			const Converter::FormatSpec spec = *Converter::parseFormatSpec(specText);
+			Converter::OutputBuffer out;
+			record("format", type, "toString", "codec", measure(c_formatCount, [&]()
+				{
+					for (const auto& val : values)
+					{
+						out.clear();
+						Converter::getStringForType(val, spec, out);
+						g_sink = g_sink + out.size();
+					}
+				}));
+
+			const std::any anyValue = values.front();
+			record("format", type, "toString", "registry_by_index", measure(c_formatCount, [&]()
+				{
+					for (std::size_t i = 0; i < values.size(); i++)
+					{
+						out.clear();
+						Converter::getStringFromAny(std::type_index(typeid(T)), anyValue, spec, out);
+						g_sink = g_sink + out.size();
+					}
+				}));
+
+			record("format", type, "toString", "std_format", measure(c_formatCount, [&]()
+				{
+					for (const auto& val : values)
+						g_sink = g_sink + formatStd(val).size();
+				}));
+		};
+
+		bench("double_.3f", doubles, ".3f", [](double val) { return std::format("{:.3f}", val); });
+		bench("double_>12.4e", doubles, ">12.4e", [](double val) { return std::format("{:>12.4e}", val); });
+		bench("int64_#018x", integers, "#018x", [](std::int64_t val) { return std::format("{:#018x}", val); });
+	}
+
+	// Distinct types to fill the registry with; they share int's conversion functions
+	template <std::size_t N>
+	struct Filler
+	{
+	};
+
+	template <std::size_t... Is>
+	std::vector<const std::type_info*> getFillerTypes(std::index_sequence<Is...>)
+	{
+		return { &typeid(Filler<Is>)... };
+	}
+
+	// Lookups by type index and by name, cycling through every registered key, as the registry grows
+	void benchRegistryGrowth()
+	{
+		const std::vector<const std::type_info*> fillers = getFillerTypes(std::make_index_sequence<c_registrySizes.back()>());
+		const Converter::ConverterInfo intConverter = *Converter::Impl::findConverter(std::type_index(typeid(int)));
+		const std::any intValue = 123456789;
+
+		std::size_t nextFiller = 0;
+		std::size_t registrySize = Converter::Impl::getRegisteredConverters().size();
+		auto benchSize = [&]()
+			{
+				std::vector<std::type_index> indexes;
+				std::vector<std::string> names;
+				for (const auto* converter : Converter::Impl::getRegisteredConverters())
+				{
+					indexes.push_back(converter->getIndex());
+					names.emplace_back(converter->name);
+				}
+				const std::size_t size = indexes.size();
+				const std::size_t passes = c_valueCount / size + 1;
+
+				record("registry", "all", "lookup", "type_index", measure(passes * size, [&]()
+					{
+						for (std::size_t pass = 0; pass < passes; pass++)
+							for (const auto& index : indexes)
+								g_sink = g_sink + (Converter::Impl::findConverter(index) != nullptr);
+					}), size);
+				record("registry", "all", "lookup", "name", measure(passes * size, [&]()
+					{
+						for (std::size_t pass = 0; pass < passes; pass++)
+							for (const auto& name : names)
+								g_sink = g_sink + (Converter::Impl::findConverter(std::string_view(name)) != nullptr);
+					}), size);
+
+				Converter::OutputBuffer out;
+				record("registry", "int", "toString", "type_index", measure(c_valueCount, [&]()
+					{
+						for (std::size_t i = 0; i < c_valueCount; i++)
+						{
+							out.clear();
+							Converter::getStringFromAny(std::type_index(typeid(int)), intValue, out);
+							g_sink = g_sink + out.size();
+						}
+					}), size);
+				record("registry", "int", "toString", "name", measure(c_valueCount, [&]()
+					{
+						for (std::size_t i = 0; i < c_valueCount; i++)
+						{
+							out.clear();
+							Converter::getStringFromAny(std::string_view("int"), intValue, out);
+							g_sink = g_sink + out.size();
+						}
+					}), size);
+			};
+
+		// Starts from the built-in converters
+		benchSize();
+		for (std::size_t target : c_registrySizes)
+		{
+			for (; registrySize < target; registrySize++)
+			{
+				const std::string name = "Filler" + std::to_string(nextFiller);
+				Converter::ConverterInfo info = intConverter;
+				info.name = name;
+				info.type = fillers[nextFiller++];
+				Converter::Impl::addConverter(info);
+			}
+			benchSize();
+		}
+	}
+
+	void writeJsonString(std::ostream& stream, std::string_view str)
+	{
+		stream << '"';
+		for (char c : str)
+		{
+			if (c == '"' || c == '\\')
+				stream << '\\';
+			stream << c;
+		}
+		stream << '"';
+	}
+
+	void writeJson(std::ostream& stream)
+	{
+		stream << "{\n"
+			<< "  \"valueCount\": " << c_valueCount << ",\n"
+			<< "  \"repetitions\": " << c_repetitions << ",\n"
+			<< "  \"results\": [\n";
+		for (std::size_t i = 0; i < g_results.size(); i++)
+		{
+			const Result& result = g_results[i];
+			stream << "    {\"group\": ";
+			writeJsonString(stream, result.group);
+			stream << ", \"type\": ";
+			writeJsonString(stream, result.type);
+			stream << ", \"operation\": ";
+			writeJsonString(stream, result.operation);
+			stream << ", \"path\": ";
+			writeJsonString(stream, result.path);
+			if (result.registrySize)
+				stream << ", \"registrySize\": " << result.registrySize;
+			stream << std::format(", \"nsPerOp\": {:.3f}, \"allocsPerOp\": {:.3f}}}", result.measurement.nsPerOp, result.measurement.allocsPerOp)
+				<< (i + 1 < g_results.size() ? ",\n" : "\n");
+		}
+		stream << "  ]\n}\n";
+	}
+
+	void logResults()
+	{
+		for (const Result& result : g_results)
+		{
+			Log::Info().log("{:<9} {:<26} {:<10} {:<20} {:>5} {:9.2f} ns/op {:6.2f} allocs/op",
+				result.group, result.type, result.operation, result.path,
+				result.registrySize ? std::to_string(result.registrySize) : std::string(),
+				result.measurement.nsPerOp, result.measurement.allocsPerOp);
+		}
+	}
+}
+
+// Counts every heap allocation in the process for the allocs/op figures
+void* operator new(std::size_t size)
+{
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* ptr = std::malloc(size ? size : 1))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+int main(int argc, char** argv)
+{
+	Log::LogInitOptions opts;
+	opts.printLocationInfo = false;
+	Log::initLogging(std::cerr, opts);
+	Converter::initializeConverters();
+
+	std::mt19937_64 rng(1234);
+
+	benchType<int>(rng);
+	benchType<float>(rng);
+	benchType<double>(rng);
+	benchType<bool>(rng);
+	benchType<std::string>(rng);
+	benchType<char>(rng);
+	benchType<std::int8_t>(rng);
+	benchType<std::int16_t>(rng);
+	benchType<std::int64_t>(rng);
+	benchType<std::uint8_t>(rng);
+	benchType<std::uint16_t>(rng);
+	benchType<std::uint32_t>(rng);
+	benchType<std::uint64_t>(rng);
+	benchType<long double>(rng);
+	benchType<Log::Color>(rng);
+	benchType<Log::Level>(rng);
+	benchType<std::vector<int>>(rng);
+	benchType<std::vector<float>>(rng);
+	benchType<std::vector<double>>(rng);
+	benchType<std::vector<std::string>>(rng);
+
+	benchLegacy<int>(rng, [](int val) { return std::to_string(val); }, [](const std::string& str) { return std::stoi(str); });
+	benchLegacy<std::int64_t>(rng, [](std::int64_t val) { return std::to_string(val); }, [](const std::string& str) { return std::stoll(str); });
+	benchLegacy<float>(rng, [](float val) { return std::to_string(val); }, [](const std::string& str) { return std::stof(str); });
+	benchLegacy<double>(rng, [](double val) { return std::to_string(val); }, [](const std::string& str) { return std::stod(str); });
+
+	benchDispatch();
+	benchBulk(rng);
+	benchBatch<std::int32_t>(rng);
+	benchBatch<std::uint32_t>(rng);
+	benchBatch<std::int64_t>(rng);
+	benchBatch<std::uint64_t>(rng);
+	benchBatch<double>(rng);
+	benchParallel<std::int64_t>(rng);
+	benchParallel<double>(rng);
+	benchBytes(rng);
+	benchChrono(rng);
+	benchFormatSpecs(rng);
+	benchRegistryGrowth();
+
+	logResults();
+
+	if (argc > 1)
+	{
+		std::ofstream file(argv[1]);
+		writeJson(file);
+	}
+	else
+	{
+		writeJson(std::cout);
+	}
+}
@@ -0,0 +1,196 @@
+#include <Logger/Logger.h>
+#include <Logger/LogIndex.h>
+
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <print>
+#include <string>
+#include <string_view>
+
+// Query tool for indexed log files
+// Uses the sidecar index written by the logger (LogInitOptions::IndexSettings) to seek straight to
+// the blocks that overlap a time range and, optionally, only to the blocks holding Error/Critical records.
+//
+// Usage:
+//    LogQuery <log file> <index file> [--from <time>] [--to <time>] [--utc] [--errors]
+//
+// Times are either milliseconds since the Unix epoch or "YYYY-MM-DD HH:MM:SS[.fff]" ('T' separator also accepted).
+// The latter are local time like the timestamps of TimeMode::Absolute log lines, so one can be copied
+// from a log line as is; pass --utc to read them as UTC instead.
+// Records written after the last index block (e.g. flushLogIndex was not called) are not indexed
+// and are always printed.
+namespace
+{
+	void printUsage()
+	{
+		std::print(std::cerr,
+			"Usage: LogQuery <log file> <index file> [--from <time>] [--to <time>] [--utc] [--errors]\n"
+			"   <time> is milliseconds since the Unix epoch or \"YYYY-MM-DD HH:MM:SS[.fff]\" in local time (UTC with --utc)\n"
+		);
+	}
+
+	template <typename T>
+	bool parseNumber(std::string_view str, T& out)
+	{
+		auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), out);
+		return ec == std::errc() && ptr == str.data() + str.size();
+	}
+
+	std::optional<std::chrono::system_clock::time_point> parseTime(std::string_view str, bool utc)
+	{
+		using namespace std::chrono;
+
+		long long epochMs = 0;
+		if (parseNumber(str, epochMs))
+			return system_clock::time_point(milliseconds(epochMs));
+
+		// YYYY-MM-DD?HH:MM:SS[.fff]
+		int y = 0;
+		unsigned mo = 0, d = 0, h = 0, mi = 0, s = 0, ms = 0;
+		if (str.size() < 19 || str[4] != '-' || str[7] != '-' || (str[10] != ' ' && str[10] != 'T') || str[13] != ':' || str[16] != ':')
+			return std::nullopt;
+		if (!parseNumber(str.substr(0, 4), y) || !parseNumber(str.substr(5, 2), mo) || !parseNumber(str.substr(8, 2), d)
+			|| !parseNumber(str.substr(11, 2), h) || !parseNumber(str.substr(14, 2), mi) || !parseNumber(str.substr(17, 2), s))
+			return std::nullopt;
+		if (str.size() > 19)
+		{
+			std::string_view frac = str.substr(20);
+			if (str[19] != '.' || frac.empty() || frac.size() > 3 || !parseNumber(frac, ms))
+				return std::nullopt;
+			for (std::size_t i = frac.size(); i < 3; i++)
+				ms *= 10;
+		}
+
+		const year_month_day date{ year(y), month(mo), day(d) };
+		if (!date.ok() || h > 23 || mi > 59 || s > 59)
+			return std::nullopt;
+
+		const auto time = local_days(date) + hours(h) + minutes(mi) + seconds(s) + milliseconds(ms);
+		if (utc)
+			return sys_time<milliseconds>(time.time_since_epoch());
+
+		// Times repeated when the clocks go back resolve to their first occurrence
+		return current_zone()->to_sys(time, choose::earliest);
+	}
+
+	bool isErrorLine(std::string_view line)
+	{
+		return line.find("[" + Log::getStringForLevel(Log::Level::Error) + "]") != std::string_view::npos
+			|| line.find("[" + Log::getStringForLevel(Log::Level::Critical) + "]") != std::string_view::npos;
+	}
+
+	// Print [offset, offset + size) of the log, optionally only the error lines
+	void printRange(std::ifstream& log, std::uint64_t offset, std::uint64_t size, bool errorsOnly)
+	{
+		std::string buffer(size, '\0');
+		log.clear();
+		log.seekg(static_cast<std::streamoff>(offset));
+		log.read(buffer.data(), static_cast<std::streamsize>(size));
+		buffer.resize(static_cast<std::size_t>(log.gcount()));
+
+		if (!errorsOnly)
+		{
+			std::cout << buffer;
+			return;
+		}
+
+		std::string_view view = buffer;
+		while (!view.empty())
+		{
+			const std::size_t end = view.find('\n');
+			const std::string_view line = view.substr(0, end == std::string_view::npos ? view.size() : end + 1);
+			if (isErrorLine(line))
+				std::cout << line;
+			view.remove_prefix(line.size());
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		printUsage();
+		return 1;
+	}
+
+	auto from = std::chrono::system_clock::time_point::min();
+	auto to = std::chrono::system_clock::time_point::max();
+	bool errorsOnly = false;
+	bool utc = false;
+	// Parsed once all options are known, as --utc may come after them
+	std::optional<std::string_view> fromArg;
+	std::optional<std::string_view> toArg;
+
+	for (int i = 3; i < argc; i++)
+	{
+		const std::string_view arg = argv[i];
+		if (arg == "--errors")
+		{
+			errorsOnly = true;
+		}
+		else if (arg == "--utc")
+		{
+			utc = true;
+		}
+		else if ((arg == "--from" || arg == "--to") && i + 1 < argc)
+		{
+			(arg == "--from" ? fromArg : toArg) = argv[++i];
+		}
+		else
+		{
+			printUsage();
+			return 1;
+		}
+	}
+
+	for (auto [arg, bound] : { std::pair(fromArg, &from), std::pair(toArg, &to) })
+	{
+		if (!arg)
+			continue;
+
+		auto time = parseTime(*arg, utc);
+		if (!time)
+		{
+			std::print(std::cerr, "Invalid time: {}\n", *arg);
+			return 1;
+		}
+		*bound = *time;
+	}
+
+	std::ifstream log(argv[1], std::ios::binary);
+	std::ifstream indexFile(argv[2], std::ios::binary);
+	if (!log || !indexFile)
+	{
+		std::print(std::cerr, "Unable to open {}!\n", !log ? argv[1] : argv[2]);
+		return 1;
+	}
+
+	const auto blocks = Log::Index::readBlocks(indexFile);
+	if (blocks.empty())
+		std::print(std::cerr, "Index is empty or invalid; the whole log is unindexed\n");
+
+	const std::uint32_t levelMask = errorsOnly
+		? Log::Index::levelBit(static_cast<int>(Log::Level::Error)) | Log::Index::levelBit(static_cast<int>(Log::Level::Critical))
+		: ~0u;
+
+	const auto matches = Log::Index::findBlocks(blocks, from, to, levelMask);
+	for (const auto& block : matches)
+		printRange(log, block.offset, block.size, errorsOnly);
+
+	// Anything past the last block has not been indexed yet; it can't be skipped
+	log.clear();
+	log.seekg(0, std::ios::end);
+	const std::uint64_t logSize = static_cast<std::uint64_t>(log.tellg());
+	const std::uint64_t indexedEnd = blocks.empty() ? 0 : blocks.back().offset + blocks.back().size;
+	if (logSize > indexedEnd)
+	{
+		std::print(std::cerr, "{} trailing bytes are not indexed; printing them unfiltered by time\n", logSize - indexedEnd);
+		printRange(log, indexedEnd, logSize - indexedEnd, errorsOnly);
+	}
+
+	std::print(std::cerr, "Matched {} of {} blocks\n", matches.size(), blocks.size());
+	return 0;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Logger/LoggerExport.h>
+
+#include <cstdint>
+#include <chrono>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+// Sparse sidecar index for log streams
+// The logger can optionally write an index next to each log stream (see LogInitOptions::IndexSettings).
+// The index is a list of fixed size block entries; each block covers a contiguous byte range of
+// the log stream and records the min/max timestamp and the levels of the records inside it.
+// A reader can then seek straight to the blocks that overlap a time range or contain a given level
+// instead of scanning the whole log.
+//
+// File layout (native endianness):
+//    char[8]    magic ("LOGIDX01")
+//    BlockEntry entries[]
+namespace Log::Index
+{
+	// Magic written at the start of every index stream
+	inline constexpr char c_magic[8] = { 'L', 'O', 'G', 'I', 'D', 'X', '0', '1' };
+
+	// One block of records in the log stream
+	// Times are nanoseconds since the system_clock epoch
+	struct BlockEntry
+	{
+		std::uint64_t offset = 0;      // Byte offset of the first record in the log stream
+		std::uint64_t size = 0;        // Number of bytes covered by the block
+		std::int64_t minTime = 0;      // Time of the earliest record in the block
+		std::int64_t maxTime = 0;      // Time of the latest record in the block
+		std::uint32_t recordCount = 0; // Number of records in the block
+		std::uint32_t levelMask = 0;   // Bit (1 << Level) is set for every level present in the block
+	};
+
+	// Returns the levelMask bit for a level
+	// Takes the level as an int so this header does not depend on Logger.h
+	constexpr std::uint32_t levelBit(int level) { return std::uint32_t(1) << level; }
+
+	// Writes index entries for a single log stream
+	// Used internally by the logger; records must be added in the order they are written to the log stream.
+	class LOGGER_EXPORT Writer
+	{
+	public:
+		Writer(std::ostream& indexStream, std::uint64_t startOffset, std::size_t recordsPerBlock, std::chrono::nanoseconds blockDuration);
+		~Writer();
+
+		// Account for a record of 'size' bytes that was just written to the log stream
+		void addRecord(int level, std::chrono::system_clock::time_point time, std::uint64_t size);
+		// Write out the current (partial) block
+		void flush();
+
+	private:
+		void writeBlock();
+
+	private:
+		std::ostream* m_indexStream;
+		std::uint64_t m_offset;
+		std::size_t m_recordsPerBlock;
+		std::chrono::nanoseconds m_blockDuration;
+		BlockEntry m_block;
+	};
+
+	// Reads all block entries from an index stream
+	// Returns an empty vector if the stream does not start with the index magic
+	LOGGER_EXPORT std::vector<BlockEntry> readBlocks(std::istream& indexStream);
+
+	// Returns the blocks that overlap [from, to] and contain at least one of the levels in levelMask
+	// Pass a levelMask of ~0u to accept any level
+	LOGGER_EXPORT std::vector<BlockEntry> findBlocks(const std::vector<BlockEntry>& blocks,
+		std::chrono::system_clock::time_point from,
+		std::chrono::system_clock::time_point to,
+		std::uint32_t levelMask = ~0u);
+}
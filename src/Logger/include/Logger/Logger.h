@@ -2,11 +2,13 @@
 
 #include <Logger/LoggerExport.h>
 
+#include <string>
 #include <string_view>
-#include <sstream>
+#include <chrono>
+#include <format>
+#include <iterator>
 #include <ostream>
 #include <source_location>
-#include <print>
 #include <unordered_map>
 
 // Simple logging library
@@ -128,6 +130,19 @@ namespace Log
 			Absolute, // Print the current date time
 		}
 		timeMode = TimeMode::Relative;
+
+		// Optional sparse sidecar index for the log streams (see Logger/LogIndex.h)
+		// Every record is accounted for in a block; a block is closed once it holds
+		// recordsPerBlock records or spans blockDuration, whichever comes first.
+		// The index streams must outlive logging; call flushLogIndex before closing them.
+		struct IndexSettings
+		{
+			std::ostream* primaryIndexStream = nullptr; // Index for the primary stream, nullptr to disable
+			std::ostream* errorIndexStream   = nullptr; // Index for the error stream, ignored when both logs share one stream
+			std::size_t recordsPerBlock = 1024;         // 0 for no record limit
+			std::chrono::milliseconds blockDuration = std::chrono::milliseconds(1000); // 0 for no time limit
+		}
+		indexSettings;
 	};
 
 	// Returns a map of <color enum, string holding color escape code>
@@ -153,6 +168,44 @@ namespace Log
 	// becomes
 	//    Log::initLogging
 	LOGGER_EXPORT std::string getSimpleFunctionName(std::string_view name);
+	// Writes out the partially filled index blocks
+	// Records logged since the last completed block are not in the index until this is called
+	LOGGER_EXPORT void flushLogIndex();
+
+	namespace Impl
+	{
+		// Growable text buffer for one log message
+		// The text stays on the stack until it outgrows c_stackSize and is then moved to a heap string once,
+		// so every message is formatted in a single pass whatever its length.
+		class MessageBuffer
+		{
+		public:
+			using value_type = char;
+
+			static constexpr std::size_t c_stackSize = 256;
+
+			void push_back(char c)
+			{
+				if (m_size < c_stackSize)
+				{
+					m_stack[m_size++] = c;
+					return;
+				}
+
+				if (m_size == c_stackSize)
+					m_heap.assign(m_stack, c_stackSize);
+				m_heap.push_back(c);
+				m_size++;
+			}
+
+			std::string_view view() const { return m_size <= c_stackSize ? std::string_view(m_stack, m_size) : std::string_view(m_heap); }
+
+		private:
+			char m_stack[c_stackSize];
+			std::size_t m_size = 0;
+			std::string m_heap;
+		};
+	}
 
 	// Base class for loggers
 	// Can be used directly, but is meant to be used via the derived classes
@@ -166,12 +219,16 @@ namespace Log
 		LoggerBase(int indentaiton, Level level, const std::source_location& location);
 		virtual ~LoggerBase();
 
+		// Messages that fit in this many bytes are formatted on the stack
+		// Longer messages continue on the heap; the arguments are formatted only once either way
+		static constexpr std::size_t c_stackMessageSize = Impl::MessageBuffer::c_stackSize;
+
 		template<class... Args>
 		LoggerBase& log(std::format_string<Args...> fmt, Args&&... args)
 		{
-			std::ostringstream stream;
-			std::print(stream, fmt, std::forward<Args>(args)...);
-			logInternal(stream.view());
+			Impl::MessageBuffer message;
+			std::format_to(std::back_inserter(message), fmt, std::forward<Args>(args)...);
+			logInternal(message.view());
 			return *this;
 		}
 
@@ -0,0 +1,114 @@
+#include <Logger/LogIndex.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+	// Nanoseconds since the epoch, saturated to the int64 range
+	// system_clock ticks can be coarser than nanoseconds (100ns on MSVC), so min()/max() used as open
+	// query bounds would overflow a plain duration_cast; clamp in the clock's own period first.
+	std::int64_t toSaturatedNanoseconds(std::chrono::system_clock::time_point time)
+	{
+		using Duration = std::chrono::system_clock::duration;
+		constexpr Duration c_min = std::chrono::duration_cast<Duration>(std::chrono::nanoseconds::min());
+		constexpr Duration c_max = std::chrono::duration_cast<Duration>(std::chrono::nanoseconds::max());
+
+		const Duration sinceEpoch = std::clamp(time.time_since_epoch(), c_min, c_max);
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch).count();
+	}
+}
+
+namespace Log::Index
+{
+	Writer::Writer(std::ostream& indexStream, std::uint64_t startOffset, std::size_t recordsPerBlock, std::chrono::nanoseconds blockDuration)
+		: m_indexStream(&indexStream)
+		, m_offset(startOffset)
+		, m_recordsPerBlock(recordsPerBlock)
+		, m_blockDuration(blockDuration)
+		, m_block{}
+	{
+		m_block.offset = m_offset;
+		m_indexStream->write(c_magic, sizeof(c_magic));
+		m_indexStream->flush();
+	}
+
+	Writer::~Writer() = default;
+
+	void Writer::addRecord(int level, std::chrono::system_clock::time_point time, std::uint64_t size)
+	{
+		const std::int64_t timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+
+		// Close the current block before this record if it already spans the configured duration
+		if (m_block.recordCount && m_blockDuration.count() > 0 && timeNs - m_block.minTime >= m_blockDuration.count())
+			writeBlock();
+
+		if (m_block.recordCount == 0)
+		{
+			m_block.minTime = timeNs;
+			m_block.maxTime = timeNs;
+		}
+		else
+		{
+			m_block.minTime = std::min(m_block.minTime, timeNs);
+			m_block.maxTime = std::max(m_block.maxTime, timeNs);
+		}
+
+		m_block.size += size;
+		m_block.recordCount++;
+		m_block.levelMask |= levelBit(level);
+		m_offset += size;
+
+		if (m_recordsPerBlock && m_block.recordCount >= m_recordsPerBlock)
+			writeBlock();
+	}
+
+	void Writer::flush()
+	{
+		if (m_block.recordCount)
+			writeBlock();
+	}
+
+	void Writer::writeBlock()
+	{
+		m_indexStream->write(reinterpret_cast<const char*>(&m_block), sizeof(m_block));
+		m_indexStream->flush();
+
+		m_block = BlockEntry{};
+		m_block.offset = m_offset;
+	}
+
+	std::vector<BlockEntry> readBlocks(std::istream& indexStream)
+	{
+		std::vector<BlockEntry> blocks;
+
+		char magic[sizeof(c_magic)] = {};
+		if (!indexStream.read(magic, sizeof(magic)) || !std::equal(std::begin(magic), std::end(magic), std::begin(c_magic)))
+			return blocks;
+
+		BlockEntry entry;
+		while (indexStream.read(reinterpret_cast<char*>(&entry), sizeof(entry)))
+			blocks.push_back(entry);
+
+		return blocks;
+	}
+
+	std::vector<BlockEntry> findBlocks(const std::vector<BlockEntry>& blocks,
+		std::chrono::system_clock::time_point from,
+		std::chrono::system_clock::time_point to,
+		std::uint32_t levelMask)
+	{
+		const std::int64_t fromNs = toSaturatedNanoseconds(from);
+		const std::int64_t toNs = toSaturatedNanoseconds(to);
+
+		std::vector<BlockEntry> found;
+		std::copy_if(blocks.begin(), blocks.end(), std::back_inserter(found),
+			[fromNs, toNs, levelMask](const BlockEntry& block)
+			{
+				return block.maxTime >= fromNs && block.minTime <= toNs && (block.levelMask & levelMask);
+			}
+		);
+
+		return found;
+	}
+}
@@ -1,10 +1,13 @@
 #include <Logger/Logger.h>
+#include <Logger/LogIndex.h>
 
 #include <assert.h>
 #include <mutex>
 #include <chrono>
 #include <format>
 #include <filesystem>
+#include <memory>
+#include <iterator>
 
 namespace
 {
@@ -20,6 +23,8 @@ namespace
 		std::ostream* errorStream() const;
 		const Log::LogInitOptions& getOpts() const;
 		const std::chrono::steady_clock::time_point& getInitTime() const;
+		Log::Index::Writer* primaryIndex() const;
+		Log::Index::Writer* errorIndex() const;
 
 	private:
 		std::ostream* m_primaryStream;
@@ -27,7 +32,25 @@ namespace
 		bool m_initialized;
 		Log::LogInitOptions m_opts;
 		std::chrono::steady_clock::time_point m_initTime;
+		// Shared so the error index can alias the primary index when both logs share a stream
+		std::shared_ptr<Log::Index::Writer> m_primaryIndex;
+		std::shared_ptr<Log::Index::Writer> m_errorIndex;
 	};
+
+	std::shared_ptr<Log::Index::Writer> makeIndexWriter(std::ostream& logStream, std::ostream* indexStream, const Log::LogInitOptions& opts)
+	{
+		if (!indexStream)
+			return nullptr;
+
+		// Streams that can't report a position (e.g. std::cout) are indexed from zero
+		const std::streamoff startOffset = logStream.tellp();
+		return std::make_shared<Log::Index::Writer>(
+			*indexStream,
+			startOffset > 0 ? static_cast<std::uint64_t>(startOffset) : 0,
+			opts.indexSettings.recordsPerBlock,
+			opts.indexSettings.blockDuration
+		);
+	}
 	LogManager::LogManager()
 		: m_primaryStream(nullptr)
 		, m_errorStream(nullptr)
@@ -39,6 +62,10 @@ namespace
 		, m_errorStream(&errorStream)
 		, m_initialized(true)
 		, m_opts(opts)
+		, m_primaryIndex(makeIndexWriter(primaryStream, opts.indexSettings.primaryIndexStream, opts))
+		, m_errorIndex(&primaryStream == &errorStream
+			? m_primaryIndex
+			: makeIndexWriter(errorStream, opts.indexSettings.errorIndexStream, opts))
 	{
 		m_initTime = std::chrono::steady_clock::now();
 	}
@@ -67,6 +94,16 @@ namespace
 		return m_initTime;
 	}
 
+	Log::Index::Writer* LogManager::primaryIndex() const
+	{
+		return m_primaryIndex.get();
+	}
+
+	Log::Index::Writer* LogManager::errorIndex() const
+	{
+		return m_errorIndex.get();
+	}
+
 	LogManager g_logManager;
 	std::mutex g_logMutex;
 
@@ -251,90 +288,105 @@ namespace Log
 			return;
 		}
 
-		std::ostringstream tmpBuff;
+		// The message is written to the stream as-is between the prefix and suffix; it is never copied
+		// The prefix/suffix buffers are reused per thread so a log line doesn't allocate once they have grown
+		thread_local std::string prefix;
+		thread_local std::string suffix;
+		prefix.clear();
+		suffix.clear();
+		auto prefixOut = std::back_inserter(prefix);
+		auto suffixOut = std::back_inserter(suffix);
+
+		const auto now = std::chrono::system_clock::now();
 
 		if (g_logManager.getOpts().timeMode != LogInitOptions::TimeMode::None)
 		{
 			if (g_logManager.getOpts().printColor)
-				tmpBuff << getColorStr(g_logManager.getOpts().colorSettings.timeInfo);
+				prefix += getColorStr(g_logManager.getOpts().colorSettings.timeInfo);
 
-			tmpBuff << "[";
+			prefix += "[";
 
 			if (g_logManager.getOpts().timeMode == LogInitOptions::TimeMode::Absolute)
 			{
-				auto now = std::chrono::system_clock::now();
 				std::chrono::zoned_time localTime{std::chrono::current_zone(), now};
 				// I get an intellisense error on this line lol
-				tmpBuff << std::format("{:%F %T}", localTime);
+				std::format_to(prefixOut, "{:%F %T}", localTime);
 			}
 			else if (g_logManager.getOpts().timeMode == LogInitOptions::TimeMode::Relative)
 			{
 				auto ellapsedTime = std::chrono::steady_clock::now() - g_logManager.getInitTime();
-				tmpBuff << std::format("{:%T}", ellapsedTime);
+				std::format_to(prefixOut, "{:%T}", ellapsedTime);
 			}
 
-			tmpBuff << "]";
+			prefix += "]";
 
 			if (g_logManager.getOpts().printColor)
-				tmpBuff << getColorStr(Color::reset);
+				prefix += getColorStr(Color::reset);
 
-			tmpBuff << " ";
+			prefix += " ";
 		}
 
 		if (g_logManager.getOpts().printColor)
-			tmpBuff << getColorStr(getColorForLevel(m_level));
+			prefix += getColorStr(getColorForLevel(m_level));
 
-		tmpBuff << "[" << getStringForLevel(m_level) << "]";
+		std::format_to(prefixOut, "[{}]", getStringForLevel(m_level));
 
 		for (int i = 0; i < m_indentation; i++)
 		{
-			tmpBuff << g_logManager.getOpts().indentationLevel;
+			prefix += g_logManager.getOpts().indentationLevel;
 		}
 
 		if (g_logManager.getOpts().printColor)
-			tmpBuff << getColorStr(Color::reset);
+			prefix += getColorStr(Color::reset);
 
-		tmpBuff << " " << message;
+		prefix += " ";
 
 		if (g_logManager.getOpts().printLocationInfo)
 		{
 			if (g_logManager.getOpts().printColor)
-				tmpBuff << getColorStr(g_logManager.getOpts().colorSettings.functionInfo);
+				suffix += getColorStr(g_logManager.getOpts().colorSettings.functionInfo);
 
-			tmpBuff << " --- ";
+			suffix += " --- ";
 			if (g_logManager.getOpts().logFullFunctionName)
-				tmpBuff << m_location.function_name();
+				suffix += m_location.function_name();
 			else
-				tmpBuff << getSimpleFunctionName(m_location.function_name());
+				suffix += getSimpleFunctionName(m_location.function_name());
 
-			tmpBuff << " (";
+			suffix += " (";
 
 			if (g_logManager.getOpts().logFullFilePath)
-				tmpBuff << m_location.file_name();
+				suffix += m_location.file_name();
 			else
-				tmpBuff << std::filesystem::path(m_location.file_name()).filename().string(); // .string() here to remove quotes from path
+				suffix += std::filesystem::path(m_location.file_name()).filename().string(); // .string() here to remove quotes from path
 
-			tmpBuff
-				<< ":"
-				<< m_location.line() << ","
-				<< m_location.column() << ")"
-				;
+			std::format_to(suffixOut, ":{},{})", m_location.line(), m_location.column());
 
 			if (g_logManager.getOpts().printColor)
-				tmpBuff << getColorStr(Color::reset);
+				suffix += getColorStr(Color::reset);
 		}
 
-		tmpBuff << "\n";
+		suffix += "\n";
 
-		std::ostream& stream = (m_level == Level::Error || m_level == Level::Critical)
-			? *errStreamPtr
-			: *stdStreamPtr;
+		const bool isErrorLevel = m_level == Level::Error || m_level == Level::Critical;
+		std::ostream& stream = isErrorLevel ? *errStreamPtr : *stdStreamPtr;
+		Index::Writer* index = isErrorLevel ? g_logManager.errorIndex() : g_logManager.primaryIndex();
 		{
 			std::lock_guard<std::mutex> guard(g_logMutex);
-			stream << tmpBuff.view();
+			stream << prefix << message << suffix;
+			if (index)
+				index->addRecord(static_cast<int>(m_level), now, prefix.size() + message.size() + suffix.size());
 		}
 	}
 
+	void flushLogIndex()
+	{
+		std::lock_guard<std::mutex> guard(g_logMutex);
+		if (auto* index = g_logManager.primaryIndex())
+			index->flush();
+		if (auto* index = g_logManager.errorIndex(); index && index != g_logManager.primaryIndex())
+			index->flush();
+	}
+
 	void initLogging(std::ostream& stream, const LogInitOptions& opts)
 	{
 		internalInitLogging(stream, stream, opts);
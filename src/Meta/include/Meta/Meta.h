@@ -2,8 +2,15 @@
 
 #include <Meta/MetaExport.h>
 
+#include <algorithm>
 #include <any>
 #include <vector>
+#include <format>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
 #include <string_view>
 #include <assert.h>
 #include <functional>
@@ -12,6 +19,7 @@
 #include <tuple>
 
 #include <Logger/Logger.h>
+#include <Converter/Converter.h>
 
 // TODO: Add some ways of printing an objects meta info out
 //       Should be sufficient for now to just be able to log it
@@ -35,9 +43,12 @@
 		static std::type_index s_getTypeIndex() { return std::type_index(typeid(classname)); } \
 		static std::string s_getTypeName() { return #classname; } \
 		static std::string s_getParentTypeName() { return #pclassname; } \
+		/* nullptr until Meta::initializeMetaInfo has run */ \
+		static const Meta::ClassMetaBase* s_getClassMeta() { return s_metaInit.getClassMeta(); } \
 		std::type_index getTypeIndex() const override { return s_getTypeIndex(); } \
 		std::string getTypeName() const override { return s_getTypeName(); } \
-		std::string getParentTypeName() const override { return s_getParentTypeName(); }
+		std::string getParentTypeName() const override { return s_getParentTypeName(); } \
+		const Meta::ClassMetaBase* getClassMeta() const override { return s_getClassMeta(); }
 
 #define _IMPLEMENT_META_OBJECT(classname) \
 	static_assert(std::is_base_of_v<Meta::MetaObject, classname>, "Meta objects must subclass the Meta::MetaObject class!"); \
@@ -190,11 +201,14 @@ namespace Meta
 
 	// Forward declaration
 	class ClassMetaBase;
+	class MetaObject;
 
 	// Call this function once at the start of the program to initialize all meta info
 	// from any loaded libraries
 	// This function is here to defer meta-initialization until after logging has been
 	// initialized and shared libraries have been loaded.
+	// The class registry is frozen afterwards: lookups are hashed and never lock, and classes
+	// from libraries loaded later are rejected with an error.
 	META_EXPORT void initializeMetaInfo();
 
 	// Get a pointer to a classes meta info
@@ -210,6 +224,10 @@ namespace Meta
 	{
 		return getClassMeta(std::type_index(typeid(T)));
 	}
+	// Formats all member properties of obj straight into a format context
+	// Output looks like: ClassName{prop1: value1, prop2: value2}
+	// This is what std::format / Log uses for any MetaObject, e.g. Log::Info().log("{}", obj);
+	META_EXPORT std::format_context::iterator formatTo(const MetaObject& obj, std::format_context& ctx);
 
 	// The Meta Object!
 	// The base of all classes exposed to the meta system.
@@ -223,8 +241,17 @@ namespace Meta
 		virtual std::type_index getTypeIndex() const = 0;
 		virtual std::string getTypeName() const = 0;
 		virtual std::string getParentTypeName() const = 0;
+		// The meta info of the object's most derived class, without a registry lookup
+		virtual const ClassMetaBase* getClassMeta() const = 0;
 
 		bool isOrIsDerivedFrom(std::type_index idx) const;
+		// O(1) and allocation free; false if either class is not registered
+		bool isOrIsDerivedFrom(const ClassMetaBase* meta) const;
+		template <typename T>
+		bool isOrIsDerivedFrom() const
+		{
+			return isOrIsDerivedFrom(T::s_getClassMeta());
+		}
 	};
 
 	// Base class for all properties
@@ -328,7 +355,7 @@ namespace Meta
 				return std::any();
 			}
 
-			if (obj.isOrIsDerivedFrom(std::type_index(typeid(ClassType))))
+			if (obj.template isOrIsDerivedFrom<ClassType>())
 			{
 				try
 				{
@@ -385,6 +412,20 @@ namespace Meta
 		virtual std::any createDefaultAsAny() const = 0;
 		virtual std::any getAsAny(const MetaObject& obj) const = 0;
 		virtual void setFromAny(MetaObject& obj, const std::any& val) const = 0;
+		// Formats the property value of obj into the format context without creating an intermediate std::any or string
+		// obj must be (or derive from) the class this property belongs to
+		virtual void formatTo(const MetaObject& obj, std::format_context& ctx) const = 0;
+
+		// Snapshot support (see Meta::Snapshot)
+		// A captured value lives in raw storage of getSnapshotSize bytes aligned to getSnapshotAlignment
+		virtual std::size_t getSnapshotSize() const = 0;
+		virtual std::size_t getSnapshotAlignment() const = 0;
+		// Copy constructs the value of obj into dst; obj must be (or derive from) the class this property belongs to
+		virtual void captureTo(const MetaObject& obj, std::byte* dst) const = 0;
+		// Move constructs the captured value at src into dst and destroys the value at src
+		virtual void relocateCaptured(std::byte* src, std::byte* dst) const = 0;
+		virtual void destroyCaptured(std::byte* src) const = 0;
+		virtual void formatCaptured(const std::byte* src, std::format_context& ctx) const = 0;
 
 		void setDefault(const std::any& val) { defaultValue = val; }
 		bool hasDefault() const { return defaultValue.has_value(); }
@@ -431,7 +472,7 @@ namespace Meta
 
 		std::any getAsAny(const MetaObject& obj) const override
 		{
-			if (obj.isOrIsDerivedFrom(std::type_index(typeid(ClassType))))
+			if (obj.template isOrIsDerivedFrom<ClassType>())
 			{
 				return std::any(get(static_cast<const ClassType&>(obj)));
 			}
@@ -452,7 +493,7 @@ namespace Meta
 				return;
 			}
 
-			if (obj.isOrIsDerivedFrom(std::type_index(typeid(ClassType))))
+			if (obj.template isOrIsDerivedFrom<ClassType>())
 			{
 				try
 				{
@@ -470,6 +511,45 @@ namespace Meta
 				assert(false && "Property does not belong to given object!");
 			}
 		}
+
+		std::size_t getSnapshotSize() const override { return sizeof(MemberType); }
+		std::size_t getSnapshotAlignment() const override { return alignof(MemberType); }
+
+		void captureTo(const MetaObject& obj, std::byte* dst) const override
+		{
+			std::construct_at(reinterpret_cast<MemberType*>(dst), get(static_cast<const ClassType&>(obj)));
+		}
+
+		void relocateCaptured(std::byte* src, std::byte* dst) const override
+		{
+			MemberType* val = std::launder(reinterpret_cast<MemberType*>(src));
+			std::construct_at(reinterpret_cast<MemberType*>(dst), std::move(*val));
+			std::destroy_at(val);
+		}
+
+		void destroyCaptured(std::byte* src) const override
+		{
+			std::destroy_at(std::launder(reinterpret_cast<MemberType*>(src)));
+		}
+
+		void formatCaptured(const std::byte* src, std::format_context& ctx) const override
+		{
+			formatValue(*std::launder(reinterpret_cast<const MemberType*>(src)), ctx);
+		}
+
+	protected:
+		// Uses std::formatter when the member type has one, otherwise the registered converter
+		static void formatValue(const MemberType& val, std::format_context& ctx)
+		{
+			if constexpr (std::formattable<MemberType, char>)
+				ctx.advance_to(std::format_to(ctx.out(), "{}", val));
+			else
+			{
+				Converter::Impl::ScratchBuffer scratch;
+				Converter::getStringForType(val, scratch.get());
+				ctx.advance_to(std::ranges::copy(scratch.get().view(), ctx.out()).out);
+			}
+		}
 	};
 
 	namespace Impl
@@ -497,6 +577,7 @@ namespace Meta
 
 		MemberType get(const ClassType& obj) const override { return obj.*member; };
 		void set(ClassType& obj, MemberType val) const override { obj.*member = val; };
+		void formatTo(const MetaObject& obj, std::format_context& ctx) const override { this->formatValue(static_cast<const ClassType&>(obj).*member, ctx); }
 	};
 
 	// A member property that operates off of a setter/getter member function pair
@@ -520,6 +601,7 @@ namespace Meta
 
 		MemberType get(const ClassType& obj) const override { return (obj.*getter)(); };
 		void set(ClassType& obj, MemberType val) const override { (obj.*setter)(val); };
+		void formatTo(const MetaObject& obj, std::format_context& ctx) const override { this->formatValue((static_cast<const ClassType&>(obj).*getter)(), ctx); }
 	};
 
 	//
@@ -662,6 +744,9 @@ namespace Meta
 	class META_EXPORT ClassMetaBase
 	{
 	public:
+		static constexpr std::uint32_t c_invalidClassId = UINT32_MAX;
+		static constexpr std::size_t c_invalidIndex = SIZE_MAX;
+
 		ClassMetaBase(const std::string& name, const std::string& parentName)
 			: name{ name }
 			, parentName{ parentName }
@@ -669,6 +754,8 @@ namespace Meta
 			, nonConstFunctions{}
 			, constFunctions{}
 			, parent{ nullptr }
+			, classId{ c_invalidClassId }
+			, lastDescendantId{ 0 }
 		{
 		}
 		virtual ~ClassMetaBase() = default;
@@ -679,13 +766,27 @@ namespace Meta
 
 		const std::string& getName() const { return name; }
 		const std::string& getParentName() const { return parentName; }
-		const std::vector<const MemberPropertyBase*> getMemberProps() const { return props; }
-		const MemberPropertyBase* getMemberProp(const std::string& name) const;
-		const std::vector<const MemberNonConstFunctionPropBase*> getNonConstFuncs() const { return nonConstFunctions; }
-		const MemberNonConstFunctionPropBase* getNonConstFunc(const std::string& name) const;
-		const std::vector<const MemberConstFunctionPropBase*> getConstFuncs() const { return constFunctions; }
-		const MemberConstFunctionPropBase* getConstFunc(const std::string& name) const;
+		const std::vector<const MemberPropertyBase*>& getMemberProps() const { return props; }
+		// Lookups by name hash the name once and probe a per class table built by initializeMetaInfo
+		// The returned pointers stay valid for the rest of the program, so resolve names once and keep them
+		const MemberPropertyBase* getMemberProp(std::string_view name) const;
+		// Position of the named property in getMemberProps() and getSnapshotOffsets(), or c_invalidIndex
+		// Fixed once initializeMetaInfo has run
+		std::size_t getMemberPropIndex(std::string_view name) const;
+		const std::vector<const MemberNonConstFunctionPropBase*>& getNonConstFuncs() const { return nonConstFunctions; }
+		const MemberNonConstFunctionPropBase* getNonConstFunc(std::string_view name) const;
+		const std::vector<const MemberConstFunctionPropBase*>& getConstFuncs() const { return constFunctions; }
+		const MemberConstFunctionPropBase* getConstFunc(std::string_view name) const;
 		const ClassMetaBase* getParent() const { return parent; }
+		// Dense id assigned by initializeMetaInfo, in [0, number of classes)
+		// Classes are numbered depth first, so the ids of a class's descendants directly follow its own
+		std::uint32_t getClassId() const { return classId; }
+		// True if this is other or one of its descendants; a range check on the class ids
+		bool isOrIsDerivedFrom(const ClassMetaBase& other) const { return other.classId <= classId && classId <= other.lastDescendantId; }
+		// Layout of a Meta::Snapshot of this class; offsets are parallel to getMemberProps()
+		const std::vector<std::size_t>& getSnapshotOffsets() const { return snapshotOffsets; }
+		std::size_t getSnapshotSize() const { return snapshotSize; }
+		std::size_t getSnapshotAlignment() const { return snapshotAlignment; }
 
 		template <typename T>
 		T createAsType()
@@ -700,14 +801,44 @@ namespace Meta
 		}
 
 	private:
+		// Open addressing table from names to positions in props or one of the function vectors
+		// Built with a seed that gives every name its own slot where one can be found, so a hit is one probe
+		struct NameIndex
+		{
+			struct Slot
+			{
+				std::uint64_t hash;
+				std::string_view name;
+				std::uint32_t index; // UINT32_MAX if the slot is empty
+			};
+
+			std::vector<Slot> slots; // A power of two, at most half full
+			std::uint64_t seed = 0;
+			std::uint32_t shift = 63;
+		};
+
+		// Called once the final property list is known (after parent props are merged)
+		void computeSnapshotLayout();
+		void buildNameIndexes();
+
 		std::string name;
 		std::string parentName;
 		std::vector<const MemberPropertyBase*> props;
 		std::vector<const MemberNonConstFunctionPropBase*> nonConstFunctions;
 		std::vector<const MemberConstFunctionPropBase*> constFunctions;
 		const ClassMetaBase* parent;
+		std::uint32_t classId;
+		// The largest id among this class and its descendants
+		std::uint32_t lastDescendantId;
+		std::vector<std::size_t> snapshotOffsets;
+		std::size_t snapshotSize = 0;
+		std::size_t snapshotAlignment = 1;
+		NameIndex propIndex;
+		NameIndex nonConstFunctionIndex;
+		NameIndex constFunctionIndex;
 
 		template<typename T> friend class Impl::MetaInitializer;
+		friend META_EXPORT void initializeMetaInfo();
 	};
 
 	// Small class used to store some information that is otherwise type-erased from the base class
@@ -743,6 +874,41 @@ namespace Meta
 		}
 	};
 
+	// Compact capture of the member property values of a meta object
+	// Construction copies every registered property into one contiguous buffer laid out by the class meta
+	// (a plain memcpy for trivially copyable members) with no std::any boxing and no string conversion.
+	// The values are only turned into text when the snapshot is formatted, so a snapshot can be
+	// captured on a hot path and rendered later or on another thread:
+	//    Log::Debug().log("{}", Meta::Snapshot(obj));
+	// Snapshots up to c_inlineSize bytes don't allocate.
+	class META_EXPORT Snapshot
+	{
+	public:
+		static constexpr std::size_t c_inlineSize = 128;
+
+		// If copying a value throws (e.g. a getter), the values copied so far are destroyed and the exception is rethrown
+		explicit Snapshot(const MetaObject& obj);
+		Snapshot(Snapshot&& other) noexcept;
+		Snapshot& operator=(Snapshot&& other) noexcept;
+		~Snapshot();
+
+		Snapshot(const Snapshot&) = delete;
+		Snapshot& operator=(const Snapshot&) = delete;
+
+		// nullptr if the captured object's class was not registered
+		const ClassMetaBase* getClassMeta() const { return m_meta; }
+		// Same output as Meta::formatTo on the original object
+		std::format_context::iterator formatTo(std::format_context& ctx) const;
+
+	private:
+		void release();
+		void moveFrom(Snapshot& other);
+
+		const ClassMetaBase* m_meta;
+		std::byte* m_data;
+		alignas(std::max_align_t) std::byte m_inline[c_inlineSize];
+	};
+
 	//
 	// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 	// Implementation Details
@@ -751,7 +917,7 @@ namespace Meta
 
 	namespace Impl
 	{
-		META_EXPORT void addClass(const ClassMetaBase* c);
+		META_EXPORT void addClass(ClassMetaBase* c);
 		META_EXPORT void addDelayClass(std::function<void()> call);
 		META_EXPORT void addDelayParentInitialize(std::function<void()> call);
 		META_EXPORT void addDelayMetaInitialize(std::function<void()> call);
@@ -832,11 +998,16 @@ namespace Meta
 						}
 						else
 							Log::Debug().log("No parent for class \"{}\"", m_classPtr->getName());
+
+						m_classPtr->computeSnapshotLayout();
+						m_classPtr->buildNameIndexes();
 					}
 				);
 			}
 			~MetaInitializer() = default;
 
+			const ClassMetaBase* getClassMeta() const { return m_classPtr; }
+
 			template<auto member>
 				requires std::is_member_object_pointer_v<decltype(member)>
 			auto addMember(const std::string& name)
@@ -944,3 +1115,40 @@ namespace Meta
 		};
 	}
 }
+
+// Formats any meta object through its class meta, see Meta::formatTo
+// No format spec is supported; use "{}"
+template<typename T>
+	requires std::derived_from<T, Meta::MetaObject>
+struct std::formatter<T, char>
+{
+	constexpr auto parse(std::format_parse_context& ctx)
+	{
+		if (ctx.begin() != ctx.end() && *ctx.begin() != '}')
+			throw std::format_error("Meta objects do not support format specs");
+		return ctx.begin();
+	}
+
+	auto format(const Meta::MetaObject& obj, std::format_context& ctx) const
+	{
+		return Meta::formatTo(obj, ctx);
+	}
+};
+
+// Formats a meta object snapshot, see Meta::Snapshot
+// No format spec is supported; use "{}"
+template<>
+struct std::formatter<Meta::Snapshot, char>
+{
+	constexpr auto parse(std::format_parse_context& ctx)
+	{
+		if (ctx.begin() != ctx.end() && *ctx.begin() != '}')
+			throw std::format_error("Meta snapshots do not support format specs");
+		return ctx.begin();
+	}
+
+	auto format(const Meta::Snapshot& snapshot, std::format_context& ctx) const
+	{
+		return snapshot.formatTo(ctx);
+	}
+};
@@ -1,6 +1,10 @@
 #include <Meta/Meta.h>
 
 #include <mutex>
+#include <algorithm>
+#include <bit>
+#include <string_view>
+#include <unordered_map>
 
 namespace
 {
@@ -10,17 +14,37 @@ namespace
 		MetaInfoRepo() = default;
 		~MetaInfoRepo() = default;
 
-		void addClass(const Meta::ClassMetaBase* newClass);
-		const std::vector<const Meta::ClassMetaBase*>& getAllClasses()
+		void addClass(Meta::ClassMetaBase* newClass);
+		const std::vector<Meta::ClassMetaBase*>& getAllClasses()
 		{
 			return m_allClasses;
 		}
 
+		const Meta::ClassMetaBase* findClass(const std::type_index& index) const
+		{
+			auto found = m_classesByIndex.find(index);
+			return found != m_classesByIndex.end() ? found->second : nullptr;
+		}
+
+		const Meta::ClassMetaBase* findClass(std::string_view name) const
+		{
+			auto found = m_classesByName.find(name);
+			return found != m_classesByName.end() ? found->second : nullptr;
+		}
+
+		// No classes are added after this, so the tables can be read from any thread without locking
+		void freeze() { m_frozen = true; }
+		bool isFrozen() const { return m_frozen; }
+
 	private:
-		std::vector<const Meta::ClassMetaBase*> m_allClasses;
+		std::vector<Meta::ClassMetaBase*> m_allClasses;
+		std::unordered_map<std::type_index, const Meta::ClassMetaBase*> m_classesByIndex;
+		// Keys view the names owned by the class metas, which are never freed
+		std::unordered_map<std::string_view, const Meta::ClassMetaBase*> m_classesByName;
+		bool m_frozen = false;
 	};
 
-	void MetaInfoRepo::addClass(const Meta::ClassMetaBase* newClass)
+	void MetaInfoRepo::addClass(Meta::ClassMetaBase* newClass)
 	{
 		if (!newClass)
 		{
@@ -29,11 +53,19 @@ namespace
 			return;
 		}
 
-		auto foundClass = std::find_if(m_allClasses.begin(), m_allClasses.end(), [newClass](const Meta::ClassMetaBase* comp) {return comp->getName() == newClass->getName(); });
-		if (foundClass == m_allClasses.end())
+		if (m_frozen)
+		{
+			Log::Error().log("Rejected class \"{}\"! Classes can't be registered after initializeMetaInfo", newClass->getName());
+			assert(false && "Class registered after initializeMetaInfo!");
+			return;
+		}
+
+		if (!m_classesByName.contains(newClass->getName()))
 		{
 			Log::Debug().log("Registered new class: {}", newClass->getName());
 			m_allClasses.push_back(newClass);
+			m_classesByIndex.emplace(newClass->getTypeIndex(), newClass);
+			m_classesByName.emplace(newClass->getName(), newClass);
 		}
 		else
 		{
@@ -48,6 +80,99 @@ namespace
 		return s_metaInfo;
 	}
 
+	// FNV-1a
+	std::uint64_t hashName(std::string_view name)
+	{
+		std::uint64_t hash = 14695981039346656037ull;
+		for (char c : name)
+		{
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	constexpr std::uint32_t c_emptySlot = UINT32_MAX;
+	// Seeds tried per table size before the table is grown
+	constexpr std::uint64_t c_seedAttempts = 32;
+	// Tables up to this many slots per name are searched for a collision free seed
+	constexpr std::size_t c_maxSlotsPerName = 16;
+
+	std::size_t getSlot(std::uint64_t hash, std::uint64_t seed, std::uint32_t shift)
+	{
+		return static_cast<std::size_t>(((hash ^ seed) * 0x9E3779B97F4A7C15ull) >> shift);
+	}
+
+	// Fills the table with the given seed; returns false on the first collision unless probing is allowed
+	template <typename Index, typename P>
+	bool placeNames(Index& index, const std::vector<P*>& items, std::uint64_t seed, bool allowProbing)
+	{
+		const std::size_t mask = index.slots.size() - 1;
+		for (auto& slot : index.slots)
+			slot.index = c_emptySlot;
+
+		index.seed = seed;
+		for (std::size_t i = 0; i < items.size(); i++)
+		{
+			const std::string_view name = items[i]->getName();
+			const std::uint64_t hash = hashName(name);
+			std::size_t slot = getSlot(hash, seed, index.shift);
+			while (index.slots[slot].index != c_emptySlot)
+			{
+				if (!allowProbing)
+					return false;
+				slot = (slot + 1) & mask;
+			}
+			index.slots[slot] = { hash, name, static_cast<std::uint32_t>(i) };
+		}
+		return true;
+	}
+
+	template <typename Index, typename P>
+	void buildNameIndex(Index& index, const std::vector<P*>& items)
+	{
+		index.slots.clear();
+		if (items.empty())
+			return;
+
+		for (std::size_t size = std::bit_ceil(items.size() * 2); ; size *= 2)
+		{
+			index.slots.resize(size);
+			index.shift = static_cast<std::uint32_t>(64 - std::bit_width(size - 1));
+			for (std::uint64_t seed = 0; seed < c_seedAttempts; seed++)
+			{
+				if (placeNames(index, items, seed, false))
+					return;
+			}
+
+			// Practically unreachable; the table still works, a few names just take more than one probe
+			if (size >= items.size() * c_maxSlotsPerName)
+			{
+				placeNames(index, items, 0, true);
+				return;
+			}
+		}
+	}
+
+	// Position of name in the indexed vector, or ClassMetaBase::c_invalidIndex
+	template <typename Index>
+	std::size_t findInNameIndex(const Index& index, std::string_view name)
+	{
+		if (index.slots.empty())
+			return Meta::ClassMetaBase::c_invalidIndex;
+
+		const std::uint64_t hash = hashName(name);
+		const std::size_t mask = index.slots.size() - 1;
+		for (std::size_t slot = getSlot(hash, index.seed, index.shift); ; slot = (slot + 1) & mask)
+		{
+			const auto& entry = index.slots[slot];
+			if (entry.index == c_emptySlot)
+				return Meta::ClassMetaBase::c_invalidIndex;
+			if (entry.hash == hash && entry.name == name)
+				return entry.index;
+		}
+	}
+
 	std::vector<std::function<void()>> g_addClassCallbacks;
 	std::mutex g_addClassVecMutex;
 
@@ -62,20 +187,23 @@ namespace Meta
 {
 	bool MetaObject::isOrIsDerivedFrom(std::type_index idx) const
 	{
-		const ClassMetaBase* ptr = Meta::getClassMeta(getTypeName());
-		while (ptr)
-		{
-			if (ptr->getTypeIndex() == idx)
-				return true;
-
-			ptr = ptr->getParent();
-		}
+		return isOrIsDerivedFrom(Meta::getClassMeta(idx));
+	}
 
-		return false;
+	bool MetaObject::isOrIsDerivedFrom(const ClassMetaBase* meta) const
+	{
+		const ClassMetaBase* own = getClassMeta();
+		return own && meta && own->isOrIsDerivedFrom(*meta);
 	}
 
 	void initializeMetaInfo()
 	{
+		if (getGlobalMeta().isFrozen())
+		{
+			Log::Warn().log("initializeMetaInfo has already been called!");
+			return;
+		}
+
 		// Register all classes
 		{
 			std::lock_guard<std::mutex> lock(g_addClassVecMutex);
@@ -102,72 +230,243 @@ namespace Meta
 				func();
 			}
 		}
+
+		// Number the classes depth first from each root so every subtree is one range of ids
+		{
+			const auto& classes = getGlobalMeta().getAllClasses();
+			std::unordered_map<const ClassMetaBase*, std::vector<ClassMetaBase*>> children;
+			std::vector<ClassMetaBase*> roots;
+			for (auto* c : classes)
+			{
+				if (c->getParent())
+					children[c->getParent()].push_back(c);
+				else
+					roots.push_back(c);
+			}
+
+			std::uint32_t nextId = 0;
+			auto assignIds = [&children, &nextId](auto& self, ClassMetaBase* c) -> void
+				{
+					c->classId = nextId++;
+					for (auto* child : children[c])
+						self(self, child);
+					c->lastDescendantId = nextId - 1;
+				};
+			for (auto* root : roots)
+				assignIds(assignIds, root);
+		}
+
+		getGlobalMeta().freeze();
 	}
 
 	const ClassMetaBase* getClassMeta(const std::type_index& index)
 	{
-		for (auto* c : getGlobalMeta().getAllClasses())
-			if (c->getTypeIndex() == index)
-				return c;
-
-		return nullptr;
+		return getGlobalMeta().findClass(index);
 	}
 
 	const ClassMetaBase* getClassMeta(const std::string& name)
 	{
-		for (auto* c : getGlobalMeta().getAllClasses())
-			if (c->getName() == name)
-				return c;
+		return getGlobalMeta().findClass(std::string_view(name));
+	}
+
+	std::format_context::iterator formatTo(const MetaObject& obj, std::format_context& ctx)
+	{
+		const ClassMetaBase* meta = obj.getClassMeta();
+		if (!meta)
+			return std::format_to(ctx.out(), "{}{{}}", obj.getTypeName());
+
+		ctx.advance_to(std::format_to(ctx.out(), "{}{{", meta->getName()));
+		bool first = true;
+		for (const auto* prop : meta->getMemberProps())
+		{
+			ctx.advance_to(std::format_to(ctx.out(), "{}{}: ", first ? "" : ", ", prop->getName()));
+			prop->formatTo(obj, ctx);
+			first = false;
+		}
 
-		return nullptr;
+		return std::format_to(ctx.out(), "}}");
 	}
 
-	const MemberPropertyBase* getPropMeta(const ClassMetaBase& meta, const std::string& name)
+	void ClassMetaBase::computeSnapshotLayout()
+	{
+		snapshotOffsets.clear();
+		snapshotSize = 0;
+		snapshotAlignment = 1;
+		for (const auto* prop : props)
+		{
+			const std::size_t align = prop->getSnapshotAlignment();
+			snapshotSize = (snapshotSize + align - 1) / align * align;
+			snapshotOffsets.push_back(snapshotSize);
+			snapshotSize += prop->getSnapshotSize();
+			snapshotAlignment = std::max(snapshotAlignment, align);
+		}
+	}
+
+	Snapshot::Snapshot(const MetaObject& obj)
+		: m_meta(obj.getClassMeta())
+		, m_data(nullptr)
 	{
-		for (const auto* p : meta.getMemberProps())
-			if (p->getName() == name)
-				return p;
+		if (!m_meta)
+		{
+			Log::Error().log("Unable to snapshot object of type \"{}\"! Class meta not found!", obj.getTypeName());
+			assert(false && "Snapshot of unregistered meta object!");
+			return;
+		}
+
+		if (m_meta->getSnapshotSize() <= c_inlineSize && m_meta->getSnapshotAlignment() <= alignof(std::max_align_t))
+			m_data = m_inline;
+		else
+			m_data = static_cast<std::byte*>(::operator new(m_meta->getSnapshotSize(), std::align_val_t(m_meta->getSnapshotAlignment())));
 
-		return nullptr;
+		const auto& props = m_meta->getMemberProps();
+		const auto& offsets = m_meta->getSnapshotOffsets();
+		std::size_t captured = 0;
+		try
+		{
+			for (; captured < props.size(); captured++)
+				props[captured]->captureTo(obj, m_data + offsets[captured]);
+		}
+		catch (...)
+		{
+			// The destructor won't run for a constructor that throws, so undo the values captured so far here
+			for (std::size_t i = 0; i < captured; i++)
+				props[i]->destroyCaptured(m_data + offsets[i]);
+			if (m_data != m_inline)
+				::operator delete(m_data, std::align_val_t(m_meta->getSnapshotAlignment()));
+			throw;
+		}
 	}
 
-	const MemberPropertyBase* ClassMetaBase::getMemberProp(const std::string& name) const
+	Snapshot::Snapshot(Snapshot&& other) noexcept
+		: m_meta(nullptr)
+		, m_data(nullptr)
 	{
-		for (const auto* p : getMemberProps())
-			if (p->getName() == name)
-				return p;
+		moveFrom(other);
+	}
 
-		return nullptr;
+	Snapshot& Snapshot::operator=(Snapshot&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			moveFrom(other);
+		}
+		return *this;
 	}
 
+	Snapshot::~Snapshot()
+	{
+		release();
+	}
 
-	const MemberNonConstFunctionPropBase* ClassMetaBase::getNonConstFunc(const std::string& name) const
+	void Snapshot::release()
 	{
-		for (const auto* f : getNonConstFuncs())
-			if (f->getName() == name)
-				return f;
+		if (!m_meta || !m_data)
+			return;
 
-		return nullptr;
+		const auto& props = m_meta->getMemberProps();
+		const auto& offsets = m_meta->getSnapshotOffsets();
+		for (std::size_t i = 0; i < props.size(); i++)
+			props[i]->destroyCaptured(m_data + offsets[i]);
+
+		if (m_data != m_inline)
+			::operator delete(m_data, std::align_val_t(m_meta->getSnapshotAlignment()));
+
+		m_meta = nullptr;
+		m_data = nullptr;
 	}
 
-	const MemberConstFunctionPropBase* ClassMetaBase::getConstFunc(const std::string& name) const
+	void Snapshot::moveFrom(Snapshot& other)
 	{
-		for (const auto* f : getConstFuncs())
-			if (f->getName() == name)
-				return f;
+		m_meta = other.m_meta;
+		if (other.m_data != other.m_inline)
+		{
+			// Heap storage can simply change owners
+			m_data = other.m_data;
+		}
+		else if (m_meta)
+		{
+			// Inline values may point into themselves (e.g. small strings) so they are moved one at a time
+			m_data = m_inline;
+			const auto& props = m_meta->getMemberProps();
+			const auto& offsets = m_meta->getSnapshotOffsets();
+			for (std::size_t i = 0; i < props.size(); i++)
+				props[i]->relocateCaptured(other.m_data + offsets[i], m_data + offsets[i]);
+		}
+
+		other.m_meta = nullptr;
+		other.m_data = nullptr;
+	}
+
+	std::format_context::iterator Snapshot::formatTo(std::format_context& ctx) const
+	{
+		if (!m_meta || !m_data)
+			return std::format_to(ctx.out(), "{{}}");
+
+		ctx.advance_to(std::format_to(ctx.out(), "{}{{", m_meta->getName()));
+		const auto& props = m_meta->getMemberProps();
+		const auto& offsets = m_meta->getSnapshotOffsets();
+		for (std::size_t i = 0; i < props.size(); i++)
+		{
+			ctx.advance_to(std::format_to(ctx.out(), "{}{}: ", i ? ", " : "", props[i]->getName()));
+			props[i]->formatCaptured(m_data + offsets[i], ctx);
+		}
+
+		return std::format_to(ctx.out(), "}}");
+	}
+
+	const MemberPropertyBase* getPropMeta(const ClassMetaBase& meta, const std::string& name)
+	{
+		return meta.getMemberProp(name);
+	}
 
-		return nullptr;
+	void ClassMetaBase::buildNameIndexes()
+	{
+		buildNameIndex(propIndex, props);
+		buildNameIndex(nonConstFunctionIndex, nonConstFunctions);
+		buildNameIndex(constFunctionIndex, constFunctions);
+	}
+
+	const MemberPropertyBase* ClassMetaBase::getMemberProp(std::string_view name) const
+	{
+		const std::size_t index = findInNameIndex(propIndex, name);
+		return index != c_invalidIndex ? props[index] : nullptr;
+	}
+
+	std::size_t ClassMetaBase::getMemberPropIndex(std::string_view name) const
+	{
+		return findInNameIndex(propIndex, name);
+	}
+
+	const MemberNonConstFunctionPropBase* ClassMetaBase::getNonConstFunc(std::string_view name) const
+	{
+		const std::size_t index = findInNameIndex(nonConstFunctionIndex, name);
+		return index != c_invalidIndex ? nonConstFunctions[index] : nullptr;
+	}
+
+	const MemberConstFunctionPropBase* ClassMetaBase::getConstFunc(std::string_view name) const
+	{
+		const std::size_t index = findInNameIndex(constFunctionIndex, name);
+		return index != c_invalidIndex ? constFunctions[index] : nullptr;
 	}
 
 	namespace Impl
 	{
-		void addClass(const ClassMetaBase* c)
+		void addClass(ClassMetaBase* c)
 		{
 			getGlobalMeta().addClass(c);
 		}
 
 		void addDelayClass(std::function<void()> call)
 		{
+			// Classes from libraries loaded after initializeMetaInfo would only be queued and never registered
+			if (getGlobalMeta().isFrozen())
+			{
+				Log::Error().log("Rejected class from a library loaded after initializeMetaInfo! It will not be registered");
+				assert(false && "Class registered after initializeMetaInfo!");
+				return;
+			}
+
 			std::lock_guard<std::mutex> lock(g_addClassVecMutex);
 			g_addClassCallbacks.push_back(call);
 		}
@@ -1,8 +1,19 @@
 #include <Logger/Logger.h>
+#include <Logger/LogIndex.h>
+#include <Converter/BatchConvert.h>
 #include <Converter/Converter.h>
+#include <Converter/ParallelConvert.h>
 #include <Meta/Meta.h>
 
 #include <iostream>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <sstream>
 
 
 class ExampleStructBase : public Meta::MetaObject
@@ -86,6 +97,159 @@ IMPLEMENT_META_OBJECT(TEST)
 {
 }
 
+// Has no Converter::Traits, so it can only be reached through a registered converter
+struct Version
+{
+	int major = 0;
+	int minor = 0;
+
+	bool operator==(const Version&) const = default;
+};
+
+// Checks that a value survives a trip through its converter bit for bit
+template <typename T, typename Bits>
+bool roundTrips(T val)
+{
+	const T back = Converter::getTypeFromString<T>(Converter::getStringForType(val));
+	return std::bit_cast<Bits>(back) == std::bit_cast<Bits>(val);
+}
+
+template <typename T, typename Bits, typename Gen>
+void testRoundTrip(const char* name, Gen generate, std::size_t count)
+{
+	std::size_t failures = 0;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		const T val = generate(i);
+		if constexpr (std::is_floating_point_v<T>)
+			if (std::isnan(val))
+				continue;
+
+		if (!roundTrips<T, Bits>(val))
+		{
+			if (failures++ < 5)
+				Log::Error(1).log("{} failed to round trip: {}", name, Converter::getStringForType(val));
+		}
+	}
+
+	if (failures)
+		Log::Error().log("Round trip {}: {} of {} values failed!", name, failures, count);
+	else
+		Log::Info().log("Round trip {}: {} values ok", name, count);
+}
+
+template <typename T>
+void testIntegerRoundTrip(const char* name)
+{
+	std::mt19937_64 rng(1234);
+	testRoundTrip<T, T>(name, [&rng](std::size_t i) -> T
+		{
+			if (i == 0) return std::numeric_limits<T>::min();
+			if (i == 1) return std::numeric_limits<T>::max();
+			return static_cast<T>(rng());
+		}, 10000);
+}
+
+void testNumberRoundTrip()
+{
+	// Every 4099th float bit pattern (covers all exponents, denormals, +-0 and infinities)
+	testRoundTrip<float, std::uint32_t>("float", [](std::size_t i) { return std::bit_cast<float>(static_cast<std::uint32_t>(i * 4099)); }, (std::size_t(1) << 32) / 4099);
+
+	std::mt19937_64 rng(1234);
+	testRoundTrip<double, std::uint64_t>("double", [&rng](std::size_t) { return std::bit_cast<double>(rng()); }, 100000);
+
+	testIntegerRoundTrip<std::int8_t>("int8_t");
+	testIntegerRoundTrip<std::int16_t>("int16_t");
+	testIntegerRoundTrip<std::int32_t>("int32_t");
+	testIntegerRoundTrip<std::int64_t>("int64_t");
+	testIntegerRoundTrip<std::uint8_t>("uint8_t");
+	testIntegerRoundTrip<std::uint16_t>("uint16_t");
+	testIntegerRoundTrip<std::uint32_t>("uint32_t");
+	testIntegerRoundTrip<std::uint64_t>("uint64_t");
+}
+
+// Checks the batch kernels against the per-value converters the scalar kernels are built on
+// Covers every digit count, both ends of the range and the fields the SIMD kernels hand to the scalar parser
+template <typename T>
+void testBatchIntegers(const char* name)
+{
+	std::size_t failures = 0;
+	auto fail = [&failures, name](std::string_view what, std::string_view text)
+		{
+			if (failures++ < 5)
+				Log::Error(1).log("Batch {} failed {}: \"{}\"", name, what, text);
+		};
+
+	std::vector<T> values = { std::numeric_limits<T>::min(), std::numeric_limits<T>::max(), T(0), T(1) };
+	if constexpr (std::is_signed_v<T>)
+		values.push_back(T(-1));
+	for (T power = 10; power <= std::numeric_limits<T>::max() / 10; power *= 10)
+	{
+		values.push_back(power - 1);
+		values.push_back(power);
+		if constexpr (std::is_signed_v<T>)
+			values.push_back(T(0) - power);
+	}
+	std::mt19937_64 rng(1234);
+	for (int i = 0; i < 10000; i++)
+		values.push_back(static_cast<T>(rng() >> (rng() % 64)) * ((std::is_signed_v<T> && (rng() & 1)) ? T(-1) : T(1)));
+
+	Converter::OutputBuffer text;
+	Converter::toStrings<T>(values, text);
+	std::string expected;
+	for (std::size_t i = 0; i < values.size(); i++)
+		expected += (i > 0 ? "," : "") + Converter::getStringForType(values[i]);
+	if (text.view() != expected)
+		fail("to format", "toStrings");
+
+	std::vector<T> parsed(values.size());
+	auto count = Converter::fromStrings<T>(text.view(), parsed);
+	if (!count || *count != values.size() || parsed != values)
+		fail("to round trip", "fromStrings");
+
+	// Each field is placed first, last and before a long field so it reaches the SIMD and the scalar paths alike
+	for (std::string_view field : { "+5", "-", "", "-0", "12a", "1 ", "00000000000000000001", "0000000000000000000000042",
+		"2147483647", "2147483648", "-2147483648", "-2147483649", "4294967295", "4294967296",
+		"9223372036854775807", "9223372036854775808", "-9223372036854775808", "-9223372036854775809",
+		"18446744073709551615", "18446744073709551616", "99999999999999999999", "123456789012345678901" })
+	{
+		const auto reference = Converter::tryParse<T>(field);
+		const std::pair<std::string, std::size_t> batches[] =
+		{
+			{ std::string(field) + ",0000000000000012,7", 0 },
+			{ "7,0000000000000012," + std::string(field), 2 },
+			{ "7," + std::string(field), 1 },
+		};
+		for (const auto& [batch, fieldIndex] : batches)
+		{
+			std::vector<T> out(3);
+			const auto result = Converter::fromStrings<T>(batch, out);
+			if (reference ? (!result || out[fieldIndex] != *reference) : (result || result.error().index != fieldIndex || result.error().error != reference.error()))
+				fail("to match tryParse", batch);
+		}
+	}
+
+	std::vector<T> two(2);
+	const auto overflow = Converter::fromStrings<T>("1,2,3", two);
+	if (overflow || overflow.error().index != 2 || overflow.error().error != Converter::ConvertError::TrailingCharacters)
+		fail("to stop at the end of values", "1,2,3");
+	if (Converter::fromStrings<T>("", two) != 0)
+		fail("to parse nothing", "");
+
+	if (failures)
+		Log::Error().log("Batch {}: {} checks failed! ({} kernels)", name, failures, Converter::Impl::getBatchKernelName());
+	else
+		Log::Info().log("Batch {}: {} values ok ({} kernels)", name, values.size(), Converter::Impl::getBatchKernelName());
+}
+
+void testBatchConvert()
+{
+	testBatchIntegers<std::int32_t>("int32_t");
+	testBatchIntegers<std::uint32_t>("uint32_t");
+	testBatchIntegers<std::int64_t>("int64_t");
+	testBatchIntegers<std::uint64_t>("uint64_t");
+}
+
 int main()
 {
 	Log::initLogging(std::cout, std::cerr);
@@ -105,9 +269,132 @@ int main()
 	Log::Info(2).log("Test of indentation!");
 
 	ExampleStruct obj{11, false, 10.0f};
+	Log::Info().log("Formatted meta object: {}", obj);
+	Meta::Snapshot snapshot(obj);
+	Log::Info().log("Formatted meta snapshot: {}", snapshot);
+	Log::Info().log("Formatted with converter: {}", Converter::formatted(3.5));
+	Log::Info().log("Enum converter: {} / {}", Converter::formatted(Log::Color::bold_red), static_cast<int>(Converter::getTypeFromString<Log::Level>("Error")));
+
+	std::map<std::string, std::vector<int>> composite{ { "a", { 1, 2, 3 } }, { "b \"quoted\"", {} } };
+	Log::Info().log("Composite converter: {}", Converter::getStringForType(composite));
+	if (auto parsed = Converter::tryParse<std::map<std::string, std::vector<int>>>(Converter::getStringForType(composite)))
+		Log::Info().log("Composite round trip: {}", *parsed == composite);
+
+	Converter::ByteWriter bytes;
+	Converter::getBytesForType(composite, bytes);
+	Converter::ByteReader reader(bytes.bytes());
+	if (auto decoded = Converter::getTypeFromBytes<std::map<std::string, std::vector<int>>>(reader))
+		Log::Info().log("Binary round trip: {} ({} bytes)", *decoded == composite, bytes.size());
+
+	Converter::Base64<std::vector<std::uint8_t>> blob{ { 'h', 'e', 'l', 'l', 'o' } };
+	std::vector<std::byte> hash{ std::byte(0xde), std::byte(0xad), std::byte(0xbe), std::byte(0xef) };
+	Log::Info().log("Byte converters: {} / {}", Converter::getStringForType(hash), Converter::getStringForType(blob));
+
+	const std::chrono::sys_seconds launch = std::chrono::sys_days{ std::chrono::year{ 1969 } / 7 / 16 } + std::chrono::hours{ 13 } + std::chrono::minutes{ 32 };
+	const auto timeout = Converter::getTypeFromString<std::chrono::milliseconds>("PT1M30.5S");
+	Log::Info().log("Chrono converters: {} / {} ms / {}", Converter::getStringForType(launch), timeout.count(), Converter::getStringForType(std::chrono::hours{ 36 }));
+
+	// Invalid dates are neither written nor parsed; month 200 would index past the two digit table
+	Converter::OutputBuffer badDates;
+	const bool wroteBadDate = Converter::Impl::writeIsoDate(std::chrono::year{ 2023 } / 2 / 30, badDates)
+		|| Converter::Impl::writeIsoDate(std::chrono::year{ 2023 } / std::chrono::month{ 200 } / 1, badDates);
+	if (wroteBadDate || badDates.size() || Converter::tryParse<std::chrono::year_month_day>("2023-02-30"))
+		Log::Error().log("Invalid date check failed! Wrote \"{}\"", badDates.view());
+	else
+		Log::Info().log("Invalid date check ok");
+
+	// Every standard integer type has a converter of its own, and the fixed width names find them on any platform
+	{
+		const std::string longLong = Converter::getStringFromAny(std::type_index(typeid(long long)), std::any(-5LL));
+		const std::string unsignedLong = Converter::getStringFromAny(std::type_index(typeid(unsigned long)), std::any(7UL));
+		const std::string int64 = Converter::getStringFromAny(std::string("std::int64_t"), std::any(std::int64_t(-9)));
+		const std::any uint32 = Converter::getAnyFromString(std::string_view("std::uint32_t"), "42");
+		const std::uint32_t* uint32Value = std::any_cast<std::uint32_t>(&uint32);
+		if (longLong == "-5" && unsignedLong == "7" && int64 == "-9" && uint32Value && *uint32Value == 42)
+			Log::Info().log("Integer converters ok");
+		else
+			Log::Error().log("Integer converters failed! long long: \"{}\", unsigned long: \"{}\", std::int64_t: \"{}\"", longLong, unsignedLong, int64);
+	}
+
+	// A try converter registered with the library's own std::function types must fit the registry's inline thunks
+	{
+		Converter::ToCharsFunc<Version> versionToChars = [](const Version& val, Converter::OutputBuffer& out)
+			{
+				Converter::getStringForType(val.major, out);
+				out.push_back('.');
+				Converter::getStringForType(val.minor, out);
+			};
+		Converter::TryFromCharsFunc<Version> versionFromChars = [](std::string_view str) -> std::expected<Version, Converter::ConvertError>
+			{
+				const std::size_t dot = str.find('.');
+				if (dot == std::string_view::npos)
+					return std::unexpected(Converter::ConvertError::InvalidSyntax);
+				auto major = Converter::tryParse<int>(str.substr(0, dot));
+				auto minor = Converter::tryParse<int>(str.substr(dot + 1));
+				if (!major || !minor)
+					return std::unexpected(!major ? major.error() : minor.error());
+				return Version{ *major, *minor };
+			};
+		REGISTER_TRY_CONVERTER(Version, versionToChars, versionFromChars)
+
+		const std::string versionText = Converter::getStringFromAny(std::type_index(typeid(Version)), std::any(Version{ 1, 2 }));
+		const auto version = Converter::tryParse<Version>(versionText);
+		const auto badVersion = Converter::tryParse<Version>("1.x");
+		if (versionText == "1.2" && version && *version == Version{ 1, 2 } && !badVersion && badVersion.error() == Converter::ConvertError::InvalidSyntax)
+			Log::Info().log("Try converter round trip ok");
+		else
+			Log::Error().log("Try converter round trip failed! Wrote \"{}\"", versionText);
+	}
+
+	// Index round trip; the open bounds min()/max() used by LogQuery must select every block
+	{
+		std::stringstream indexStream;
+		const auto indexStart = std::chrono::system_clock::now();
+		{
+			Log::Index::Writer writer(indexStream, 0, 2, std::chrono::nanoseconds{ 0 });
+			for (int i = 0; i < 5; i++)
+				writer.addRecord(i == 3 ? int(Log::Level::Error) : int(Log::Level::Info), indexStart + std::chrono::seconds{ i }, 10);
+			writer.flush();
+		}
+		const auto blocks = Log::Index::readBlocks(indexStream);
+		const auto all = Log::Index::findBlocks(blocks, std::chrono::system_clock::time_point::min(), std::chrono::system_clock::time_point::max());
+		const auto late = Log::Index::findBlocks(blocks, indexStart + std::chrono::seconds{ 4 }, std::chrono::system_clock::time_point::max());
+		const auto errors = Log::Index::findBlocks(blocks, std::chrono::system_clock::time_point::min(), std::chrono::system_clock::time_point::max(), Log::Index::levelBit(int(Log::Level::Error)));
+		if (blocks.size() == 3 && all.size() == 3 && late.size() == 1 && late[0].offset == 40 && errors.size() == 1 && errors[0].offset == 20)
+			Log::Info().log("Index round trip ok");
+		else
+			Log::Error().log("Index round trip failed! Blocks: {}, all: {}, late: {}, errors: {}", blocks.size(), all.size(), late.size(), errors.size());
+	}
+
+	constexpr auto priceSpec = Converter::parseFormatSpec(">10.2f");
+	Log::Info().log("Format specs: [{}] [{}] [{:*^12}]", Converter::getStringForType(3.14159, *priceSpec),
+		Converter::getStringFromAny(std::type_index(typeid(int)), std::any(255), *Converter::parseFormatSpec("#06x")), Converter::formatted(std::vector<int>{ 1, 2, 3 }));
+
+	std::vector<std::int64_t> series(100000);
+	for (std::size_t i = 0; i < series.size(); i++)
+		series[i] = static_cast<std::int64_t>(i * i) - 5000;
+	Converter::OutputBuffer seriesText;
+	Converter::parallelToStrings<std::int64_t>(series, seriesText);
+	std::vector<std::int64_t> seriesParsed(series.size());
+	auto seriesCount = Converter::parallelFromStrings<std::int64_t>(seriesText.view(), seriesParsed);
+	Log::Info().log("Parallel round trip: {} values, {} chars, {}", seriesCount.value_or(0), seriesText.size(), seriesParsed == series);
+
+	for (std::string_view input : { "42", "42abc", "99999999999", "" })
+	{
+		auto parsed = Converter::tryParse<int>(input);
+		if (parsed)
+			Log::Info().log("tryParse<int>(\"{}\") = {}", input, *parsed);
+		else
+			Log::Info().log("tryParse<int>(\"{}\") failed: {}", input, Converter::getStringForError(parsed.error()));
+	}
+
 	auto* objMeta = Meta::getClassMeta<ExampleStruct>();
 	if (objMeta)
 	{
+		Log::Info().log("Class ids: {} derives {} = {}, is TEST = {}", objMeta->getClassId(), ExampleStructBase::s_getClassMeta()->getClassId(),
+			obj.isOrIsDerivedFrom<ExampleStructBase>(), obj.isOrIsDerivedFrom<TEST>());
+		Log::Info().log("Property index of \"three\": {}", objMeta->getMemberPropIndex("three"));
+
 		for (const auto* prop : objMeta->getMemberProps())
 		{
 			Log::Info().log("Property: Name = {}, Value = {}", prop->getName(), Converter::getStringFromAny(prop->getTypeIndex(), prop->getAsAny(obj)));
@@ -137,4 +424,9 @@ int main()
 		}
 	}
 
+	testNumberRoundTrip();
+	testBatchConvert();
+
+	// Counts the type erased conversions above when built with CONVERTER_STATS
+	Converter::dumpStats();
 }
\ No newline at end of file